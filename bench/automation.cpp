@@ -0,0 +1,67 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "automation.h"
+#include "../src/paramids.h"
+#include <math.h>
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+
+namespace Igorski {
+namespace Automation {
+
+const int PARAMETER_AMOUNT = kDistortionChainId - kVowelLId + 1;
+
+// the length (in samples) of a ramp cycle for given parameter
+
+static double getPeriod( ParamID id )
+{
+    return ( double ) ( 8 + id * 3 ) * 512.0;
+}
+
+void generate( IParameterChanges* changes, long long position, int blockSize, int points )
+{
+    for ( ParamID id = kVowelLId; id <= kDistortionChainId; ++id ) {
+        int32 index = 0;
+        IParamValueQueue* queue = changes->addParameterData( id, index );
+
+        if ( queue == nullptr ) {
+            continue;
+        }
+        const double period = getPeriod( id );
+
+        for ( int p = 0; p < points; ++p ) {
+            int32 offset = points > 1 ? ( int32 ) (( int64 ) p * ( blockSize - 1 ) / ( points - 1 )) : blockSize - 1;
+            double phase     = fmod(( double ) ( position + offset ), period ) / period;
+            ParamValue value = phase < 0.5 ? phase * 2.0 : 2.0 - phase * 2.0;
+
+            if ( id == kVowelSyncId || id == kDistortionTypeId || id == kDistortionChainId ) {
+                value *= 0.45;
+            }
+            queue->addPoint( offset, value, index );
+        }
+    }
+}
+
+}
+}
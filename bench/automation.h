@@ -1,7 +1,7 @@
 /**
  * The MIT License (MIT)
  *
- * Copyright (c) 2018 Igor Zinken - https://www.igorski.nl
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy of
  * this software and associated documentation files (the "Software"), to deal in
@@ -20,56 +20,30 @@
  * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
  * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
-#ifndef __UTIL_HEADER__
-#define __UTIL_HEADER__
+#ifndef __AUTOMATION_H_INCLUDED__
+#define __AUTOMATION_H_INCLUDED__
 
-#include <fstream>
-#include <string>
-#include <time.h>
+#include "pluginterfaces/vst/ivstparameterchanges.h"
 
+/**
+ * Host-style parameter automation used by the benchmark tools: fills a parameter
+ * change list with ramps for all automatable parameters (see paramids.h). The ramps
+ * are triangles at a distinct rate per parameter. The boolean parameters are ramped
+ * within their lower half so these don't toggle (which would change the cost of the
+ * audio processing, e.g. when vowel sync allows dual mono processing)
+ */
 namespace Igorski {
-namespace Util {
-
-    /**
-     * Convenience method to log a message to a file
-     * multiple messages can be written to the same file (are
-     * separated by a new line)
-     *
-     * This should be used for debugging purposes only
-     */
-    void log( const char* message, const char* filename )
-    {
-        std::ofstream out;
-
-        char buff[20];
-        struct tm *sTm;
-
-        time_t now = time( 0 );
-        sTm        = gmtime( &now );
-
-        strftime( buff, sizeof( buff ), "%Y-%m-%d %H:%M:%S", sTm );
-
-        out.open( filename, std::ios_base::app );
-        out << buff << " " << message << "\n";
-
-        out.close();
-    }
+namespace Automation {
 
-    void log( std::string message, const char* filename )
-    {
-        log( message.c_str(), filename );
-    }
+    // the amount of automatable parameters
 
-    void log( float value, const char* filename )
-    {
-        log( std::to_string( value ), filename );
-    }
+    extern const int PARAMETER_AMOUNT;
 
-    void log( int value, const char* filename )
-    {
-        log( std::to_string( value ), filename );
-    }
+    // adds given amount of points (evenly distributed over the block) for each automatable
+    // parameter to given parameter changes, for a block of given size starting at given
+    // position (in samples). The changes should be empty (e.g. cleared by the host)
 
+    void generate( Steinberg::Vst::IParameterChanges* changes, long long position, int blockSize, int points );
 }
 }
 
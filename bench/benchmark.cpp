@@ -0,0 +1,913 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "automation.h"
+#include "perfcounters.h"
+#include "testsignals.h"
+#include "../src/audiobuffer.h"
+#include "../src/bitcrusher.h"
+#include "../src/formantfilter.h"
+#include "../src/limiter.h"
+#include "../src/oversampler.h"
+#include "../src/pluginprocess.h"
+#include "../src/quality.h"
+#include "../src/vst.h"
+#include "../src/waveshaper.h"
+#include "public.sdk/source/vst/hosting/parameterchanges.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <sys/resource.h>
+#endif
+
+/**
+ * Benchmark runner for the DSP classes. Each kernel is run for a fixed amount
+ * of blocks (after a warm up) and reported in nanoseconds per sample. When run
+ * with --perf, the hardware performance counters are read around each kernel
+ * (see perfcounters.h), counters that are not available are reported as "n/a".
+ *
+ * The automation benchmarks drive Transformant::process with host-style parameter
+ * ramps (--points per parameter per block) for all automatable parameters, to
+ * measure the cost of the control path (reading the parameter queues, syncModel()
+ * and the processor setters) separately from the audio processing.
+ *
+ * The scaling benchmarks process a growing amount of PluginProcess instances (up
+ * to --instances) from a pool of --threads threads, the way the multi-core engine
+ * of a host processes its tracks (synchronizing the threads at every block).
+ *
+ * The lifecycle benchmark measures the time, heap memory and page faults of each
+ * stage an instance goes through when a host loads a project (construction,
+ * initialize(), setupProcessing(), setActive() and the first process() calls).
+ *
+ * usage: benchmark [--blocks <amount>] [--block-size <samples>] [--points <amount>]
+ *                  [--instances <amount>] [--threads <amount>] [--perf] [--filter <name>]
+ *
+ * (the scaling and lifecycle benchmarks use --instances as the maximum amount of instances)
+ */
+using namespace Igorski;
+
+static const float SAMPLE_RATE   = 44100.f;
+static const int   CHANNELS      = 2;
+static const int   WARMUP_BLOCKS = 64;
+
+// the amount of distinct blocks of parameter automation (generated up front)
+
+static const int AUTOMATION_BLOCKS = 64;
+
+struct Options {
+    int blocks         = 2000;
+    int blockSize      = 512;
+    int points         = 32;
+    int instances      = 256;
+    int threads        = std::max( 1, ( int ) std::thread::hardware_concurrency());
+    bool perf          = false;
+    const char* filter = nullptr;
+};
+
+static Options options;
+static PerfCounters* counters = nullptr;
+
+static void printCounter( PerfCounters::Counter counter, double samples )
+{
+    if ( !counters->isAvailable( counter )) {
+        printf( "  %14s: n/a\n", PerfCounters::NAMES[ counter ]);
+        return;
+    }
+    uint64_t value = counters->getValue( counter );
+    printf( "  %14s: %14llu (%.3f per sample)\n", PerfCounters::NAMES[ counter ],
+        ( unsigned long long ) value, ( double ) value / samples
+    );
+}
+
+// prints the values of all counters (when reading the counters is enabled) relative to given amount of samples
+
+static void printCounters( double samples )
+{
+    if ( counters == nullptr ) {
+        return;
+    }
+    printCounter( PerfCounters::INSTRUCTIONS, samples );
+    printCounter( PerfCounters::CYCLES, samples );
+
+    if ( counters->isAvailable( PerfCounters::INSTRUCTIONS ) && counters->isAvailable( PerfCounters::CYCLES )) {
+        printf( "  %14s: %.3f\n", "IPC", counters->getIPC());
+    } else {
+        printf( "  %14s: n/a\n", "IPC" );
+    }
+    printCounter( PerfCounters::L1D_MISSES,    samples );
+    printCounter( PerfCounters::L2_MISSES,     samples );
+    printCounter( PerfCounters::LLC_MISSES,    samples );
+    printCounter( PerfCounters::BRANCH_MISSES, samples );
+    printCounter( PerfCounters::FP_ASSISTS,    samples );
+    printCounter( PerfCounters::PAGE_FAULTS,   samples );
+}
+
+// runs given kernel (which processes a single block of options.blockSize samples per invocation)
+// and reports its timing (and optionally the hardware counters). Returns the average time
+// spent per block (in nanoseconds) or 0 when the kernel was not run
+
+static double run( const char* name, int channels, std::function<void()> kernel )
+{
+    if ( options.filter != nullptr && strstr( name, options.filter ) == nullptr ) {
+        return 0.0;
+    }
+
+    for ( int i = 0; i < WARMUP_BLOCKS; ++i ) {
+        kernel();
+    }
+
+    if ( counters != nullptr ) {
+        counters->start();
+    }
+    auto start = std::chrono::steady_clock::now();
+
+    for ( int i = 0; i < options.blocks; ++i ) {
+        kernel();
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    if ( counters != nullptr ) {
+        counters->stop();
+    }
+
+    double samples = ( double ) options.blocks * options.blockSize * channels;
+    double ns      = ( double ) std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count();
+
+    printf( "%-36s %10.3f ns/sample %10.2f x realtime\n", name, ns / samples,
+        (( samples / channels ) / SAMPLE_RATE ) / ( ns / 1e9 )
+    );
+
+    printCounters( samples );
+
+    return ns / options.blocks;
+}
+
+static void benchmarkKernels()
+{
+    const int size = options.blockSize;
+
+    AudioBuffer* source = new AudioBuffer( CHANNELS, size );
+    AudioBuffer* buffer = new AudioBuffer( CHANNELS, size * Oversampler::FACTOR );
+
+    for ( int c = 0; c < CHANNELS; ++c ) {
+        TestSignals::generate( TestSignals::NOISE, source->getBufferForChannel( c ), size, c, SAMPLE_RATE );
+    }
+    double* in  = source->getBufferForChannel( 0 );
+    double* out = buffer->getBufferForChannel( 0 );
+
+    // restores the source signal into the processing buffer, as most kernels process in place
+    // (this copy is included in the measurements, but negligible)
+
+    auto restore = [ & ]() {
+        memcpy( out, in, size * sizeof( double ));
+    };
+
+    FormantFilter formantFilter( 0.5f, SAMPLE_RATE );
+    run( "FormantFilter::process", 1, [ & ]() {
+        restore();
+        formantFilter.process( out, size );
+    });
+
+    FormantFilter lfoFormantFilter( 0.5f, SAMPLE_RATE );
+    lfoFormantFilter.setLFO( 0.5f, 0.75f );
+    run( "FormantFilter::process (LFO)", 1, [ & ]() {
+        restore();
+        lfoFormantFilter.process( out, size );
+    });
+
+    WaveShaper waveShaper( 0.75f, 1.f );
+    run( "WaveShaper::process", 1, [ & ]() {
+        restore();
+        waveShaper.process( out, size );
+    });
+
+    BitCrusher bitCrusher( 0.5f, 1.f, 1.f );
+    run( "BitCrusher::process", 1, [ & ]() {
+        restore();
+        bitCrusher.process( out, size );
+    });
+
+    Limiter limiter( 10.f, 500.f, 0.6f );
+    double* channels[ CHANNELS ] = { buffer->getBufferForChannel( 0 ), buffer->getBufferForChannel( 1 ) };
+    run( "Limiter::process", CHANNELS, [ & ]() {
+        for ( int c = 0; c < CHANNELS; ++c ) {
+            memcpy( channels[ c ], source->getBufferForChannel( c ), size * sizeof( double ));
+        }
+        limiter.process<double>( channels, size, CHANNELS );
+    });
+
+    Oversampler oversampler;
+    run( "Oversampler::upsample+downsample", 1, [ & ]() {
+        oversampler.upsample( in, out, size );
+        oversampler.downsample( out, out, size );
+    });
+
+    run( "AudioBuffer::analyse", CHANNELS, [ & ]() {
+        for ( int c = 0; c < CHANNELS; ++c ) {
+            volatile double peak = source->analyse( c ).peak;
+            ( void ) peak;
+        }
+    });
+
+    delete source;
+    delete buffer;
+}
+
+static void benchmarkPluginProcess()
+{
+    const int size = options.blockSize;
+
+    AudioBuffer* source = new AudioBuffer( CHANNELS, size );
+    AudioBuffer* buffer = new AudioBuffer( CHANNELS, size );
+
+    for ( int c = 0; c < CHANNELS; ++c ) {
+        TestSignals::generate( TestSignals::NOISE, source->getBufferForChannel( c ), size, c, SAMPLE_RATE );
+    }
+    double* channels[ CHANNELS ] = { buffer->getBufferForChannel( 0 ), buffer->getBufferForChannel( 1 ) };
+
+    const char* names[ Quality::TIER_AMOUNT ] = {
+        "PluginProcess::process (low)", "PluginProcess::process (realtime)", "PluginProcess::process (offline)"
+    };
+
+    for ( int tier = 0; tier < Quality::TIER_AMOUNT; ++tier ) {
+        PluginProcess* pluginProcess = new PluginProcess( CHANNELS, SAMPLE_RATE );
+        pluginProcess->reconfigure( SAMPLE_RATE, size, CHANNELS );
+        pluginProcess->setQuality(( Quality::Tier ) tier );
+
+        // use distinct settings per channel so the dual mono optimization does not apply
+
+        pluginProcess->getFormantFilter( 0 )->setVowel( 0.4f );
+        pluginProcess->getFormantFilter( 1 )->setVowel( 0.6f );
+        pluginProcess->getFormantFilter( 0 )->setLFO( 0.3f, 0.5f );
+        pluginProcess->getFormantFilter( 1 )->setLFO( 0.5f, 0.8f );
+        pluginProcess->waveShaper->setAmount( 0.5f );
+
+        run( names[ tier ], CHANNELS, [ & ]() {
+            for ( int c = 0; c < CHANNELS; ++c ) {
+                memcpy( channels[ c ], source->getBufferForChannel( c ), size * sizeof( double ));
+            }
+            pluginProcess->process<double>( channels, channels, CHANNELS, CHANNELS, size, size * sizeof( double ));
+        });
+
+#ifdef ENABLE_STAGE_PROBES
+        Stage::Stats* stats = pluginProcess->getStageStats();
+        for ( int stage = 0; stage < Stage::AMOUNT; ++stage ) {
+            uint64_t cycles = 0;
+            uint64_t calls  = 0;
+            for ( int c = 0; c < VST::MAX_CHANNELS; ++c ) {
+                cycles += stats->channels[ c ].cycles[ stage ];
+                calls  += stats->channels[ c ].calls[ stage ];
+            }
+            if ( calls > 0 ) {
+                printf( "  %14s: %.1f cycles per call\n", Stage::NAMES[ stage ], ( double ) cycles / ( double ) calls );
+            }
+        }
+#endif
+        delete pluginProcess;
+    }
+
+    // hosts do not necessarily provide blocks of a constant size (e.g. when splitting blocks at loop
+    // points or automation changes). Process the same amount of samples per iteration in a (fixed seed)
+    // sequence of random chunk sizes to measure the overhead of irregular blocks relative to the above
+
+    std::vector<int> chunks;
+    uint32_t seed = 0x5EED;
+
+    for ( int remaining = size; remaining > 0; ) {
+        seed = seed * 1664525u + 1013904223u;
+        int chunk = std::min( remaining, 1 + ( int )(( seed >> 8 ) % ( uint32_t ) size ));
+        chunks.push_back( chunk );
+        remaining -= chunk;
+    }
+
+    PluginProcess* pluginProcess = new PluginProcess( CHANNELS, SAMPLE_RATE );
+    pluginProcess->reconfigure( SAMPLE_RATE, size, CHANNELS );
+    pluginProcess->getFormantFilter( 0 )->setVowel( 0.4f );
+    pluginProcess->getFormantFilter( 1 )->setVowel( 0.6f );
+    pluginProcess->getFormantFilter( 0 )->setLFO( 0.3f, 0.5f );
+    pluginProcess->getFormantFilter( 1 )->setLFO( 0.5f, 0.8f );
+    pluginProcess->waveShaper->setAmount( 0.5f );
+
+    run( "PluginProcess::process (jittered)", CHANNELS, [ & ]() {
+        for ( int c = 0; c < CHANNELS; ++c ) {
+            memcpy( channels[ c ], source->getBufferForChannel( c ), size * sizeof( double ));
+        }
+        double* chunkChannels[ CHANNELS ];
+        int offset = 0;
+
+        for ( int chunk : chunks ) {
+            for ( int c = 0; c < CHANNELS; ++c ) {
+                chunkChannels[ c ] = channels[ c ] + offset;
+            }
+            pluginProcess->process<double>( chunkChannels, chunkChannels, CHANNELS, CHANNELS, chunk, chunk * sizeof( double ));
+            offset += chunk;
+        }
+    });
+
+    delete pluginProcess;
+    delete source;
+    delete buffer;
+}
+
+// single precision stereo in- and output buses (the input holding noise) as provided by a host
+
+struct HostBuses {
+    float* inputChannels [ CHANNELS ];
+    float* outputChannels[ CHANNELS ];
+    AudioBusBuffers inputs;
+    AudioBusBuffers outputs;
+
+    HostBuses( int size )
+    {
+        double* signal = new double[ size ];
+
+        for ( int c = 0; c < CHANNELS; ++c ) {
+            inputChannels [ c ] = new float[ size ];
+            outputChannels[ c ] = new float[ size ];
+
+            TestSignals::generate( TestSignals::NOISE, signal, size, c, SAMPLE_RATE );
+            for ( int i = 0; i < size; ++i ) {
+                inputChannels[ c ][ i ] = ( float ) signal[ i ];
+            }
+        }
+        delete[] signal;
+
+        inputs.numChannels       = CHANNELS;
+        inputs.silenceFlags      = 0;
+        inputs.channelBuffers32  = inputChannels;
+        outputs.numChannels      = CHANNELS;
+        outputs.silenceFlags     = 0;
+        outputs.channelBuffers32 = outputChannels;
+    }
+
+    ~HostBuses()
+    {
+        for ( int c = 0; c < CHANNELS; ++c ) {
+            delete[] inputChannels [ c ];
+            delete[] outputChannels[ c ];
+        }
+    }
+
+    // prepares given process data for a realtime block of given size using these buses
+
+    void prepare( ProcessData& data, int size, IParameterChanges* inputChanges, IParameterChanges* outputChanges )
+    {
+        data.processMode            = kRealtime;
+        data.symbolicSampleSize     = kSample32;
+        data.numSamples             = size;
+        data.numInputs              = 1;
+        data.numOutputs             = 1;
+        data.inputs                 = &inputs;
+        data.outputs                = &outputs;
+        data.inputParameterChanges  = inputChanges;
+        data.outputParameterChanges = outputChanges;
+        data.inputEvents            = nullptr;
+        data.outputEvents           = nullptr;
+        data.processContext         = nullptr;
+    }
+};
+
+static void benchmarkAutomation()
+{
+    const int size = options.blockSize;
+
+    Transformant* plugin = new Transformant();
+    plugin->initialize( nullptr );
+
+    ProcessSetup setup;
+    setup.processMode        = kRealtime;
+    setup.symbolicSampleSize = kSample32;
+    setup.maxSamplesPerBlock = size;
+    setup.sampleRate         = SAMPLE_RATE;
+
+    plugin->setupProcessing( setup );
+    plugin->setActive( true );
+
+    HostBuses buses( size );
+
+    // parameter changes (generated up front so only the processors handling of the changes is measured)
+
+    const int parameterAmount = Automation::PARAMETER_AMOUNT;
+
+    ParameterChanges* automation[ AUTOMATION_BLOCKS ];
+    for ( int i = 0; i < AUTOMATION_BLOCKS; ++i ) {
+        automation[ i ] = new ParameterChanges( parameterAmount );
+        Automation::generate( automation[ i ], ( long long ) i * size, size, options.points );
+    }
+    ParameterChanges noChanges;
+    ParameterChanges outputChanges( parameterAmount );
+
+    ProcessData data;
+    buses.prepare( data, size, &noChanges, &outputChanges );
+
+    int block = 0;
+
+    // the block without any buses only runs the control path (Transformant::process returns after syncModel())
+
+    double controlTime = run( "Transformant::process (control path)", CHANNELS, [ & ]() {
+        data.numInputs             = 0;
+        data.numOutputs            = 0;
+        data.inputParameterChanges = automation[ block++ % AUTOMATION_BLOCKS ];
+        outputChanges.clearQueue();
+        plugin->process( data );
+    });
+
+    double staticTime = run( "Transformant::process (static)", CHANNELS, [ & ]() {
+        data.numInputs             = 1;
+        data.numOutputs            = 1;
+        data.inputParameterChanges = &noChanges;
+        outputChanges.clearQueue();
+        plugin->process( data );
+    });
+
+    double automatedTime = run( "Transformant::process (automated)", CHANNELS, [ & ]() {
+        data.numInputs             = 1;
+        data.numOutputs            = 1;
+        data.inputParameterChanges = automation[ block++ % AUTOMATION_BLOCKS ];
+        outputChanges.clearQueue();
+        plugin->process( data );
+    });
+
+    const double deadline = 1.0e9 * size / SAMPLE_RATE;
+
+    if ( controlTime > 0.0 ) {
+        printf( "  control path: %.0f ns per block (%.3f%% of the block deadline), %.1f ns per parameter point\n",
+            controlTime, controlTime / deadline * 100.0, controlTime / ( parameterAmount * options.points )
+        );
+    }
+    if ( staticTime > 0.0 && automatedTime > 0.0 ) {
+        printf( "  automation overhead: %.0f ns per block (%.3f%% of the block deadline)\n",
+            automatedTime - staticTime, ( automatedTime - staticTime ) / deadline * 100.0
+        );
+    }
+
+    plugin->setActive( false );
+    plugin->terminate();
+    plugin->release();
+
+    for ( int i = 0; i < AUTOMATION_BLOCKS; ++i ) {
+        delete automation[ i ];
+    }
+}
+
+// the amount of bytes currently allocated on the heap, -1 when this cannot be determined
+
+static long long getHeapUsage()
+{
+#if defined( __GLIBC__ ) && ( __GLIBC__ > 2 || ( __GLIBC__ == 2 && __GLIBC_MINOR__ >= 33 ))
+    struct mallinfo2 info = mallinfo2();
+    return ( long long ) ( info.uordblks + info.hblkhd );
+#else
+    return -1;
+#endif
+}
+
+// barrier synchronizing the processing threads at the start and end of each block
+// threads yield while waiting (rather than sleeping) as an audio engine would
+
+class SpinBarrier
+{
+    public:
+        SpinBarrier( int amount ) : _amount( amount ), _waiting( 0 ), _generation( 0 ) {}
+
+        void wait()
+        {
+            int generation = _generation.load( std::memory_order_acquire );
+
+            if ( _waiting.fetch_add( 1, std::memory_order_acq_rel ) + 1 == _amount ) {
+                _waiting.store( 0, std::memory_order_relaxed );
+                _generation.fetch_add( 1, std::memory_order_release );
+                return;
+            }
+            while ( _generation.load( std::memory_order_acquire ) == generation ) {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        int _amount;
+        std::atomic<int> _waiting;
+        std::atomic<int> _generation;
+};
+
+struct Instance {
+    PluginProcess* pluginProcess;
+    AudioBuffer* buffer;
+};
+
+// processes a single block for the given amount of instances from given amount of threads
+// where each thread takes the next unprocessed instance until all have been processed
+// (returns the time spent in nanoseconds, measured over the processing of all cycles)
+
+static double processInstances( std::vector<Instance>& instances, AudioBuffer* source, int threadAmount, int cycles, int warmupCycles )
+{
+    const int size = options.blockSize;
+
+    std::atomic<int>  nextInstance( 0 );
+    std::atomic<bool> running( true );
+    SpinBarrier barrier( threadAmount );
+
+    auto processBlock = [ & ]() {
+        for ( int i = nextInstance.fetch_add( 1 ); i < ( int ) instances.size(); i = nextInstance.fetch_add( 1 )) {
+            Instance& instance = instances[ i ];
+            double* channels[ CHANNELS ];
+
+            for ( int c = 0; c < CHANNELS; ++c ) {
+                channels[ c ] = instance.buffer->getBufferForChannel( c );
+                memcpy( channels[ c ], source->getBufferForChannel( c ), size * sizeof( double ));
+            }
+            instance.pluginProcess->process<double>( channels, channels, CHANNELS, CHANNELS, size, size * sizeof( double ));
+        }
+    };
+
+    // the calling thread processes instances too
+
+    std::vector<std::thread> threads;
+    for ( int t = 1; t < threadAmount; ++t ) {
+        threads.emplace_back([ & ]() {
+            while ( true ) {
+                barrier.wait();
+                if ( !running.load( std::memory_order_acquire )) {
+                    break;
+                }
+                processBlock();
+                barrier.wait();
+            }
+        });
+    }
+
+    auto cycle = [ & ]() {
+        nextInstance.store( 0, std::memory_order_relaxed );
+        barrier.wait();
+        processBlock();
+        barrier.wait();
+    };
+
+    for ( int i = 0; i < warmupCycles; ++i ) {
+        cycle();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    for ( int i = 0; i < cycles; ++i ) {
+        cycle();
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    running.store( false, std::memory_order_release );
+    barrier.wait();
+
+    for ( auto& thread : threads ) {
+        thread.join();
+    }
+    return ( double ) std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count();
+}
+
+static void benchmarkScaling()
+{
+    const char* name = "PluginProcess scaling";
+
+    if ( options.filter != nullptr && strstr( name, options.filter ) == nullptr ) {
+        return;
+    }
+
+    const int size = options.blockSize;
+    const double deadline = 1.0e9 * size / SAMPLE_RATE;
+
+    AudioBuffer* source = new AudioBuffer( CHANNELS, size );
+    for ( int c = 0; c < CHANNELS; ++c ) {
+        TestSignals::generate( TestSignals::NOISE, source->getBufferForChannel( c ), size, c, SAMPLE_RATE );
+    }
+
+    printf( "%s (%d threads)\n", name, options.threads );
+
+    double singleInstanceCost = 0.0;
+
+    for ( int amount = 1; amount <= options.instances; amount = ( amount == options.instances ) ? amount + 1 : std::min( amount * 2, options.instances )) {
+        std::vector<Instance> instances( amount );
+
+        // measure the heap usage of the processors (the I/O buffers are owned by the host)
+
+        long long heapBefore = getHeapUsage();
+
+        for ( int i = 0; i < amount; ++i ) {
+            PluginProcess* pluginProcess = new PluginProcess( CHANNELS, SAMPLE_RATE );
+            pluginProcess->reconfigure( SAMPLE_RATE, size, CHANNELS );
+
+            // vary the settings per instance (as in a session with different tracks)
+
+            float position = ( float ) i / ( float ) amount;
+            pluginProcess->getFormantFilter( 0 )->setVowel( position );
+            pluginProcess->getFormantFilter( 1 )->setVowel( 1.f - position );
+            pluginProcess->getFormantFilter( 0 )->setLFO( 0.2f + position * 0.5f, 0.5f );
+            pluginProcess->getFormantFilter( 1 )->setLFO( 0.6f - position * 0.5f, 0.7f );
+            pluginProcess->waveShaper->setAmount( position );
+
+            instances[ i ].pluginProcess = pluginProcess;
+        }
+        long long heapAfter = getHeapUsage();
+
+        for ( int i = 0; i < amount; ++i ) {
+            instances[ i ].buffer = new AudioBuffer( CHANNELS, size );
+        }
+
+        // the amount of cycles is scaled down as the amount of instances grows, keeping the total work comparable
+
+        int threadAmount = std::min( options.threads, amount );
+        int cycles       = std::max( 1, options.blocks / amount );
+        int warmupCycles = std::max( 1, WARMUP_BLOCKS / amount );
+
+        if ( counters != nullptr ) {
+            counters->start();
+        }
+        double ns = processInstances( instances, source, threadAmount, cycles, warmupCycles );
+
+        if ( counters != nullptr ) {
+            counters->stop();
+        }
+
+        // the cost of a single instance block in thread time (as all threads are occupied
+        // while processing) indicates the effect of contention (e.g. for shared caches)
+
+        double instanceBlocks = ( double ) amount * cycles;
+        double instanceCost   = ns * threadAmount / instanceBlocks;
+        double cycleTime      = ns / cycles;
+
+        if ( amount == 1 ) {
+            singleInstanceCost = instanceCost;
+        }
+
+        printf( "  %3d instances: %10.2f x realtime aggregate, %9.0f ns per instance block (%5.1f%% of a single instance), load %6.1f%%",
+            amount, ( instanceBlocks * size / SAMPLE_RATE ) / ( ns / 1e9 ), instanceCost,
+            instanceCost / singleInstanceCost * 100.0, cycleTime / deadline * 100.0
+        );
+
+        if ( heapBefore >= 0 ) {
+            printf( ", %.1f KB per instance\n", ( double ) ( heapAfter - heapBefore ) / amount / 1024.0 );
+        } else {
+            printf( ", memory n/a\n" );
+        }
+
+        // the counters include the warmup and the threads spawned for the measurement
+
+        printCounters(( double ) ( cycles + warmupCycles ) * amount * size * CHANNELS );
+
+        for ( auto& instance : instances ) {
+            delete instance.pluginProcess;
+            delete instance.buffer;
+        }
+    }
+    delete source;
+}
+
+// the amount of page faults (e.g. upon first touch of newly allocated memory) of the process
+// to date, -1 when this cannot be determined
+
+static long long getPageFaults()
+{
+#if defined( __unix__ ) || defined( __APPLE__ )
+    struct rusage usage;
+    if ( getrusage( RUSAGE_SELF, &usage ) == 0 ) {
+        return ( long long ) ( usage.ru_minflt + usage.ru_majflt );
+    }
+#endif
+    return -1;
+}
+
+namespace Lifecycle {
+
+    enum Stage {
+        CONSTRUCT = 0,
+        INITIALIZE,
+        SETUP_PROCESSING,
+        ACTIVATE,
+        FIRST_PROCESS,
+        SECOND_PROCESS,
+        AMOUNT
+    };
+
+    static const char* NAMES[ AMOUNT ] = {
+        "constructor", "initialize", "setupProcessing", "setActive", "first process", "second process"
+    };
+
+    // the resources consumed by a stage
+
+    struct Usage {
+        double    ns         = 0.0;
+        long long bytes      = 0;
+        long long pageFaults = 0;
+    };
+
+    // executes given stage, adding its consumed resources to given usage
+
+    static void measure( Usage& usage, std::function<void()> stage )
+    {
+        long long heapBefore   = getHeapUsage();
+        long long faultsBefore = getPageFaults();
+        auto start = std::chrono::steady_clock::now();
+
+        stage();
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        usage.ns         += ( double ) std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count();
+        usage.bytes      += getHeapUsage() - heapBefore;
+        usage.pageFaults += getPageFaults() - faultsBefore;
+    }
+}
+
+static void printUsage( const Lifecycle::Usage& usage, int amount )
+{
+    printf( "%10.1f us", usage.ns / amount / 1000.0 );
+
+    if ( getHeapUsage() >= 0 ) {
+        printf( " %9.1f KB", ( double ) usage.bytes / amount / 1024.0 );
+    } else {
+        printf( " %12s", "n/a" );
+    }
+
+    if ( getPageFaults() >= 0 ) {
+        printf( " %8.1f faults", ( double ) usage.pageFaults / amount );
+    } else {
+        printf( " %15s", "n/a" );
+    }
+}
+
+static void benchmarkLifecycle()
+{
+    const char* name = "Transformant lifecycle";
+
+    if ( options.filter != nullptr && strstr( name, options.filter ) == nullptr ) {
+        return;
+    }
+
+    const int size = options.blockSize;
+
+    // as during the loading of a project, all instances remain alive until all have been loaded
+    // the first instance is reported separately as it also initializes the shared state (e.g. tables)
+
+    std::vector<Transformant*> plugins( options.instances, nullptr );
+    Lifecycle::Usage first[ Lifecycle::AMOUNT ];
+    Lifecycle::Usage other[ Lifecycle::AMOUNT ];
+
+    HostBuses buses( size );
+    ParameterChanges outputChanges( 1 );
+
+    ProcessData data;
+    buses.prepare( data, size, nullptr, &outputChanges );
+
+    ProcessSetup setup;
+    setup.processMode        = kRealtime;
+    setup.symbolicSampleSize = kSample32;
+    setup.maxSamplesPerBlock = size;
+    setup.sampleRate         = SAMPLE_RATE;
+
+    for ( int i = 0; i < options.instances; ++i ) {
+        Lifecycle::Usage* usage = ( i == 0 ) ? first : other;
+
+        Lifecycle::measure( usage[ Lifecycle::CONSTRUCT ], [ & ]() {
+            plugins[ i ] = new Transformant();
+        });
+        Transformant* plugin = plugins[ i ];
+
+        Lifecycle::measure( usage[ Lifecycle::INITIALIZE ], [ & ]() {
+            plugin->initialize( nullptr );
+        });
+        Lifecycle::measure( usage[ Lifecycle::SETUP_PROCESSING ], [ & ]() {
+            plugin->setupProcessing( setup );
+        });
+        Lifecycle::measure( usage[ Lifecycle::ACTIVATE ], [ & ]() {
+            plugin->setActive( true );
+        });
+        Lifecycle::measure( usage[ Lifecycle::FIRST_PROCESS ], [ & ]() {
+            outputChanges.clearQueue();
+            plugin->process( data );
+        });
+        Lifecycle::measure( usage[ Lifecycle::SECOND_PROCESS ], [ & ]() {
+            outputChanges.clearQueue();
+            plugin->process( data );
+        });
+    }
+
+    printf( "%s (%d instances)\n", name, options.instances );
+
+    Lifecycle::Usage firstTotal;
+    Lifecycle::Usage otherTotal;
+
+    for ( int stage = 0; stage < Lifecycle::AMOUNT; ++stage ) {
+        printf( "  %16s: first", Lifecycle::NAMES[ stage ]);
+        printUsage( first[ stage ], 1 );
+
+        if ( options.instances > 1 ) {
+            printf( ", average" );
+            printUsage( other[ stage ], options.instances - 1 );
+        }
+        printf( "\n" );
+
+        firstTotal.ns         += first[ stage ].ns;
+        firstTotal.bytes      += first[ stage ].bytes;
+        firstTotal.pageFaults += first[ stage ].pageFaults;
+        otherTotal.ns         += other[ stage ].ns;
+        otherTotal.bytes      += other[ stage ].bytes;
+        otherTotal.pageFaults += other[ stage ].pageFaults;
+    }
+
+    printf( "  %16s: first", "total" );
+    printUsage( firstTotal, 1 );
+
+    if ( options.instances > 1 ) {
+        printf( ", average" );
+        printUsage( otherTotal, options.instances - 1 );
+    }
+    printf( "\n" );
+
+    for ( auto plugin : plugins ) {
+        plugin->setActive( false );
+        plugin->terminate();
+        plugin->release();
+    }
+}
+
+int main( int argc, char** argv )
+{
+    for ( int i = 1; i < argc; ++i ) {
+        if ( strcmp( argv[ i ], "--blocks" ) == 0 && i + 1 < argc ) {
+            options.blocks = atoi( argv[ ++i ]);
+        } else if ( strcmp( argv[ i ], "--block-size" ) == 0 && i + 1 < argc ) {
+            options.blockSize = atoi( argv[ ++i ]);
+        } else if ( strcmp( argv[ i ], "--points" ) == 0 && i + 1 < argc ) {
+            options.points = atoi( argv[ ++i ]);
+        } else if ( strcmp( argv[ i ], "--instances" ) == 0 && i + 1 < argc ) {
+            options.instances = atoi( argv[ ++i ]);
+        } else if ( strcmp( argv[ i ], "--threads" ) == 0 && i + 1 < argc ) {
+            options.threads = atoi( argv[ ++i ]);
+        } else if ( strcmp( argv[ i ], "--perf" ) == 0 ) {
+            options.perf = true;
+        } else if ( strcmp( argv[ i ], "--filter" ) == 0 && i + 1 < argc ) {
+            options.filter = argv[ ++i ];
+        } else {
+            printf( "usage: %s [--blocks <amount>] [--block-size <samples>] [--points <amount>]\n"
+                    "       [--instances <amount>] [--threads <amount>] [--perf] [--filter <name>]\n", argv[ 0 ]);
+            return 1;
+        }
+    }
+
+    if ( options.blocks < 1 || options.blockSize < 1 || options.points < 1 || options.instances < 1 || options.threads < 1 ) {
+        printf( "block amount, size, automation points, instances and threads must be positive\n" );
+        return 1;
+    }
+
+    if ( options.perf ) {
+        counters = new PerfCounters();
+        if ( !counters->isAvailable()) {
+            printf( "hardware performance counters unavailable (unsupported platform, or check "
+                    "/proc/sys/kernel/perf_event_paranoid), reporting timing only\n" );
+            delete counters;
+            counters = nullptr;
+        }
+    }
+
+    printf( "%d blocks of %d samples at %.0f Hz\n\n", options.blocks, options.blockSize, SAMPLE_RATE );
+
+    benchmarkKernels();
+    benchmarkPluginProcess();
+    benchmarkAutomation();
+    benchmarkScaling();
+    benchmarkLifecycle();
+
+    delete counters;
+
+    return 0;
+}
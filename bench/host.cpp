@@ -0,0 +1,305 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "automation.h"
+#include "testsignals.h"
+
+#include "public.sdk/source/vst/hosting/hostclasses.h"
+#include "public.sdk/source/vst/hosting/module.h"
+#include "public.sdk/source/vst/hosting/parameterchanges.h"
+#include "public.sdk/source/vst/hosting/processdata.h"
+#include "pluginterfaces/vst/ivstaudioprocessor.h"
+#include "pluginterfaces/vst/ivstcomponent.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+/**
+ * Minimal headless VST3 host, loading the built plugin bundle through its factory
+ * (see vstentry.cpp) to benchmark the processing end to end, e.g. including the
+ * overhead of Transformant::process itself (the parameter parsing, the channel buffer
+ * retrieval and silence checks) which is not covered by the benchmark runner.
+ *
+ * The plugin is set up as a host would (negotiating a stereo bus arrangement, setting
+ * up the processing and activating the component) after which process() is invoked
+ * for the requested amount of blocks, optionally with parameter automation.
+ *
+ * usage: host <path to transformant.vst3> [--blocks <amount>] [--block-size <samples>]
+ *             [--sample-size <32|64>] [--sample-rate <rate>] [--points <amount>]
+ *             [--offline] [--silence]
+ */
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+using namespace Igorski;
+
+static const int CHANNELS = 2;
+
+struct Options {
+    const char* path  = nullptr;
+    int blocks        = 10000;
+    int blockSize     = 512;
+    int sampleSize    = kSample32;
+    double sampleRate = 44100.0;
+    int points        = 0;     // amount of automation points per parameter per block (0 disables automation)
+    bool offline      = false;
+    bool silence      = false; // whether to provide silent input (flagged as such)
+};
+
+static Options options;
+
+// executes given host operation, returning its duration in microseconds
+
+static double measure( std::function<void()> operation )
+{
+    auto start = std::chrono::steady_clock::now();
+    operation();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    return ( double ) std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count() / 1000.0;
+}
+
+// fills the input bus of given process data with the test signal (or silence)
+// (the silence flags are provided by the host for every block)
+
+static void prepareInput( HostProcessData& data )
+{
+    AudioBusBuffers& input = data.inputs[ 0 ];
+    std::vector<double> signal( options.blockSize, 0.0 );
+
+    for ( int c = 0; c < input.numChannels; ++c ) {
+        if ( !options.silence ) {
+            TestSignals::generate( TestSignals::NOISE, signal.data(), options.blockSize, c, ( float ) options.sampleRate );
+        }
+        for ( int i = 0; i < options.blockSize; ++i ) {
+            if ( options.sampleSize == kSample64 ) {
+                input.channelBuffers64[ c ][ i ] = signal[ i ];
+            } else {
+                input.channelBuffers32[ c ][ i ] = ( float ) signal[ i ];
+            }
+        }
+    }
+}
+
+static bool parseArguments( int argc, char** argv )
+{
+    for ( int i = 1; i < argc; ++i ) {
+        if ( strcmp( argv[ i ], "--blocks" ) == 0 && i + 1 < argc ) {
+            options.blocks = atoi( argv[ ++i ]);
+        } else if ( strcmp( argv[ i ], "--block-size" ) == 0 && i + 1 < argc ) {
+            options.blockSize = atoi( argv[ ++i ]);
+        } else if ( strcmp( argv[ i ], "--sample-size" ) == 0 && i + 1 < argc ) {
+            options.sampleSize = atoi( argv[ ++i ]) == 64 ? kSample64 : kSample32;
+        } else if ( strcmp( argv[ i ], "--sample-rate" ) == 0 && i + 1 < argc ) {
+            options.sampleRate = atof( argv[ ++i ]);
+        } else if ( strcmp( argv[ i ], "--points" ) == 0 && i + 1 < argc ) {
+            options.points = atoi( argv[ ++i ]);
+        } else if ( strcmp( argv[ i ], "--offline" ) == 0 ) {
+            options.offline = true;
+        } else if ( strcmp( argv[ i ], "--silence" ) == 0 ) {
+            options.silence = true;
+        } else if ( argv[ i ][ 0 ] != '-' && options.path == nullptr ) {
+            options.path = argv[ i ];
+        } else {
+            return false;
+        }
+    }
+    return options.path != nullptr && options.blocks > 0 && options.blockSize > 0 &&
+           options.sampleRate > 0.0 && options.points >= 0;
+}
+
+int main( int argc, char** argv )
+{
+    if ( !parseArguments( argc, argv )) {
+        printf( "usage: %s <path to transformant.vst3> [--blocks <amount>] [--block-size <samples>]\n"
+                "       [--sample-size <32|64>] [--sample-rate <rate>] [--points <amount>] [--offline] [--silence]\n", argv[ 0 ]);
+        return 1;
+    }
+
+    // load the module and create the audio processor through its factory
+
+    std::string error;
+    VST3::Hosting::Module::Ptr module;
+    double loadTime = measure( [ & ]() {
+        module = VST3::Hosting::Module::create( options.path, error );
+    });
+
+    if ( !module ) {
+        printf( "could not load %s: %s\n", options.path, error.c_str());
+        return 1;
+    }
+
+    IPtr<HostApplication> hostApplication = owned( new HostApplication());
+    VST3::Hosting::PluginFactory factory = module->getFactory();
+    factory.setHostContext( hostApplication );
+
+    IPtr<IComponent> component;
+    double createTime = measure( [ & ]() {
+        for ( auto& classInfo : factory.classInfos()) {
+            if ( classInfo.category() == kVstAudioEffectClass ) {
+                component = factory.createInstance<IComponent>( classInfo.ID());
+                break;
+            }
+        }
+    });
+
+    if ( !component ) {
+        printf( "no audio effect found in %s\n", options.path );
+        return 1;
+    }
+
+    FUnknownPtr<IAudioProcessor> processor( component );
+    if ( !processor ) {
+        printf( "component does not implement IAudioProcessor\n" );
+        return 1;
+    }
+
+    tresult result = kResultOk;
+    double initializeTime = measure( [ & ]() {
+        result = component->initialize( hostApplication );
+    });
+
+    if ( result != kResultOk ) {
+        printf( "could not initialize component\n" );
+        return 1;
+    }
+
+    // negotiate the stereo bus arrangement
+
+    SpeakerArrangement inputArrangement  = SpeakerArr::kStereo;
+    SpeakerArrangement outputArrangement = SpeakerArr::kStereo;
+
+    if ( processor->setBusArrangements( &inputArrangement, 1, &outputArrangement, 1 ) != kResultOk ) {
+        printf( "stereo bus arrangement was not accepted\n" );
+        return 1;
+    }
+    component->activateBus( kAudio, kInput,  0, true );
+    component->activateBus( kAudio, kOutput, 0, true );
+
+    if ( processor->canProcessSampleSize( options.sampleSize ) != kResultTrue ) {
+        printf( "%d-bit samples are not supported\n", options.sampleSize == kSample64 ? 64 : 32 );
+        return 1;
+    }
+
+    ProcessSetup setup;
+    setup.processMode        = options.offline ? kOffline : kRealtime;
+    setup.symbolicSampleSize = options.sampleSize;
+    setup.maxSamplesPerBlock = options.blockSize;
+    setup.sampleRate         = options.sampleRate;
+
+    double setupTime = measure( [ & ]() {
+        result = processor->setupProcessing( setup );
+    });
+
+    if ( result != kResultOk ) {
+        printf( "processing setup was not accepted\n" );
+        return 1;
+    }
+
+    double activateTime = measure( [ & ]() {
+        component->setActive( true );
+        processor->setProcessing( true );
+    });
+
+    // prepare the buses and parameter changes
+
+    HostProcessData data;
+    data.prepare( *component, options.blockSize, options.sampleSize );
+    data.processMode = setup.processMode;
+    data.numSamples  = options.blockSize;
+
+    prepareInput( data );
+
+    ParameterChanges inputChanges( Automation::PARAMETER_AMOUNT );
+    ParameterChanges outputChanges( Automation::PARAMETER_AMOUNT );
+
+    data.inputParameterChanges  = &inputChanges;
+    data.outputParameterChanges = &outputChanges;
+
+    // process the blocks, timing each individually (the host side preparation
+    // of the parameter changes is excluded from the measurement)
+
+    std::vector<double> blockTimes( options.blocks );
+
+    for ( int block = 0; block < options.blocks; ++block ) {
+        inputChanges.clearQueue();
+        outputChanges.clearQueue();
+
+        if ( options.points > 0 ) {
+            Automation::generate( &inputChanges, ( long long ) block * options.blockSize, options.blockSize, options.points );
+        }
+        data.inputs[ 0 ].silenceFlags = options.silence ? ((( uint64 ) 1 << CHANNELS ) - 1 ) : 0;
+
+        auto start = std::chrono::steady_clock::now();
+        processor->process( data );
+        blockTimes[ block ] = ( double ) std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start ).count();
+    }
+
+    // report
+
+    double total = 0.0;
+    for ( double time : blockTimes ) {
+        total += time;
+    }
+    std::vector<double> sorted( blockTimes );
+    std::sort( sorted.begin(), sorted.end());
+
+    auto percentile = [ & ]( double fraction ) {
+        return sorted[ std::min(( size_t ) ( fraction * sorted.size()), sorted.size() - 1 )];
+    };
+
+    const double deadline = 1.0e9 * options.blockSize / options.sampleRate;
+    const double mean     = total / options.blocks;
+
+    printf( "%s\n", options.path );
+    printf( "%d blocks of %d samples (%d-bit, %.0f Hz, %s%s, %d automation points per parameter)\n\n",
+        options.blocks, options.blockSize, options.sampleSize == kSample64 ? 64 : 32, options.sampleRate,
+        options.offline ? "offline" : "realtime", options.silence ? ", silent input" : "", options.points
+    );
+
+    printf( "  %16s: %10.1f us\n", "load module",      loadTime );
+    printf( "  %16s: %10.1f us\n", "create instance",  createTime );
+    printf( "  %16s: %10.1f us\n", "initialize",       initializeTime );
+    printf( "  %16s: %10.1f us\n", "setupProcessing",  setupTime );
+    printf( "  %16s: %10.1f us\n", "setActive",        activateTime );
+
+    printf( "\n  process: %.3f ns/sample, %.2f x realtime, mean load %.2f%%\n",
+        mean / ( options.blockSize * CHANNELS ), deadline / mean, mean / deadline * 100.0
+    );
+    printf( "  block time (ns): min %.0f, median %.0f, 99th percentile %.0f, max %.0f (deadline %.0f)\n",
+        sorted.front(), percentile( 0.5 ), percentile( 0.99 ), sorted.back(), deadline
+    );
+
+    // tear down
+
+    processor->setProcessing( false );
+    component->setActive( false );
+    data.unprepare();
+    component->terminate();
+
+    return 0;
+}
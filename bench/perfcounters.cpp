@@ -0,0 +1,196 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "perfcounters.h"
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <stdio.h>
+#endif
+
+namespace Igorski {
+
+const char* PerfCounters::NAMES[ AMOUNT ] = {
+    "cycles", "instructions", "L1d misses", "L2 misses", "LLC misses", "branch misses", "FP assists", "page faults"
+};
+
+#ifdef __linux__
+
+static bool isIntel()
+{
+    FILE* cpuinfo = fopen( "/proc/cpuinfo", "r" );
+    if ( cpuinfo == nullptr ) {
+        return false;
+    }
+    char line[ 256 ];
+    bool intel = false;
+
+    while ( fgets( line, sizeof( line ), cpuinfo ) != nullptr ) {
+        if ( strncmp( line, "vendor_id", 9 ) == 0 ) {
+            intel = strstr( line, "GenuineIntel" ) != nullptr;
+            break;
+        }
+    }
+    fclose( cpuinfo );
+
+    return intel;
+}
+
+static int openCounter( uint32_t type, uint64_t config )
+{
+    struct perf_event_attr attributes;
+    memset( &attributes, 0, sizeof( attributes ));
+
+    attributes.size           = sizeof( attributes );
+    attributes.type           = type;
+    attributes.config         = config;
+    attributes.disabled       = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv     = 1;
+    attributes.inherit        = 1; // include threads spawned after opening (added upon their exit)
+    attributes.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // measure the calling thread (and its children) on any CPU
+
+    return ( int ) syscall( __NR_perf_event_open, &attributes, 0, -1, -1, 0 );
+}
+
+static uint64_t cacheMiss( uint64_t cache )
+{
+    return cache | ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 );
+}
+
+#endif
+
+/* constructor / destructor */
+
+PerfCounters::PerfCounters()
+{
+    for ( int i = 0; i < AMOUNT; ++i ) {
+        _descriptors[ i ] = -1;
+        _values[ i ]      = 0;
+    }
+
+#ifdef __linux__
+    _descriptors[ CYCLES ]        = openCounter( PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES );
+    _descriptors[ INSTRUCTIONS ]  = openCounter( PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS );
+    _descriptors[ L1D_MISSES ]    = openCounter( PERF_TYPE_HW_CACHE, cacheMiss( PERF_COUNT_HW_CACHE_L1D ));
+    _descriptors[ LLC_MISSES ]    = openCounter( PERF_TYPE_HW_CACHE, cacheMiss( PERF_COUNT_HW_CACHE_LL ));
+    _descriptors[ BRANCH_MISSES ] = openCounter( PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES );
+    _descriptors[ PAGE_FAULTS ]   = openCounter( PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS );
+
+    // raw events differ per vendor (and model), these are the Skylake and later
+    // encodings for L2_RQSTS.MISS and FP_ASSIST.ANY
+
+    if ( isIntel()) {
+        _descriptors[ L2_MISSES ]  = openCounter( PERF_TYPE_RAW, 0x3F24 );
+        _descriptors[ FP_ASSISTS ] = openCounter( PERF_TYPE_RAW, 0x1ECA );
+    }
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+    for ( int i = 0; i < AMOUNT; ++i ) {
+        if ( _descriptors[ i ] >= 0 ) {
+            close( _descriptors[ i ]);
+        }
+    }
+#endif
+}
+
+/* public methods */
+
+bool PerfCounters::isAvailable()
+{
+    for ( int i = 0; i < AMOUNT; ++i ) {
+        if ( _descriptors[ i ] >= 0 ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PerfCounters::isAvailable( Counter counter )
+{
+    return _descriptors[ counter ] >= 0;
+}
+
+void PerfCounters::start()
+{
+#ifdef __linux__
+    for ( int i = 0; i < AMOUNT; ++i ) {
+        if ( _descriptors[ i ] >= 0 ) {
+            ioctl( _descriptors[ i ], PERF_EVENT_IOC_RESET, 0 );
+            ioctl( _descriptors[ i ], PERF_EVENT_IOC_ENABLE, 0 );
+        }
+    }
+#endif
+}
+
+void PerfCounters::stop()
+{
+#ifdef __linux__
+    for ( int i = 0; i < AMOUNT; ++i ) {
+        if ( _descriptors[ i ] >= 0 ) {
+            ioctl( _descriptors[ i ], PERF_EVENT_IOC_DISABLE, 0 );
+        }
+    }
+
+    for ( int i = 0; i < AMOUNT; ++i ) {
+        _values[ i ] = 0;
+
+        if ( _descriptors[ i ] < 0 ) {
+            continue;
+        }
+
+        // value, time enabled and time running (the latter differ when the counters were multiplexed)
+
+        uint64_t data[ 3 ];
+
+        if ( read( _descriptors[ i ], data, sizeof( data )) != sizeof( data ) || data[ 2 ] == 0 ) {
+            continue;
+        }
+        _values[ i ] = ( uint64_t )(( double ) data[ 0 ] * (( double ) data[ 1 ] / ( double ) data[ 2 ]));
+    }
+#endif
+}
+
+uint64_t PerfCounters::getValue( Counter counter )
+{
+    return _values[ counter ];
+}
+
+double PerfCounters::getIPC()
+{
+    if ( _values[ CYCLES ] == 0 ) {
+        return 0.0;
+    }
+    return ( double ) _values[ INSTRUCTIONS ] / ( double ) _values[ CYCLES ];
+}
+
+}
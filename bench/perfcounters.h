@@ -0,0 +1,86 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __PERFCOUNTERS_H_INCLUDED__
+#define __PERFCOUNTERS_H_INCLUDED__
+
+#include <stdint.h>
+
+namespace Igorski {
+
+/**
+ * PerfCounters reads the hardware performance counters (through perf_event_open)
+ * of the calling thread in between start() and stop(). Threads spawned by the calling
+ * thread are included once they have exited (e.g. when joined before invoking stop()). This is only supported on
+ * Linux, where the availability of the counters further depends on the CPU, the
+ * kernels perf_event_paranoid setting and virtualization. Counters that could not
+ * be opened are reported as unavailable, which leaves the remaining counters usable.
+ */
+class PerfCounters
+{
+    public:
+        enum Counter {
+            CYCLES = 0,
+            INSTRUCTIONS,
+            L1D_MISSES,     // L1 data cache read misses
+            L2_MISSES,      // L2 cache misses (Intel only, model specific raw event)
+            LLC_MISSES,     // last level cache read misses
+            BRANCH_MISSES,
+            FP_ASSISTS,     // floating point assists, e.g. on denormals (Intel only, model specific raw event)
+            PAGE_FAULTS,    // e.g. upon first touch of newly allocated memory (software event)
+            AMOUNT
+        };
+
+        static const char* NAMES[ AMOUNT ];
+
+        PerfCounters();
+        ~PerfCounters();
+
+        // whether any (or given) counter is available
+
+        bool isAvailable();
+        bool isAvailable( Counter counter );
+
+        // resets and enables the counters
+
+        void start();
+
+        // disables the counters and reads their values
+
+        void stop();
+
+        // the value of given counter as read upon the last stop() (scaled in case
+        // the kernel multiplexed the counters), 0 when not available
+
+        uint64_t getValue( Counter counter );
+
+        // instructions per cycle, 0 when not available
+
+        double getIPC();
+
+    private:
+        int      _descriptors[ AMOUNT ];
+        uint64_t _values[ AMOUNT ];
+};
+}
+
+#endif
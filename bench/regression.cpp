@@ -0,0 +1,381 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "testsignals.h"
+#include "../src/pluginprocess.h"
+#include "../src/quality.h"
+#include "../src/rtsafety.h"
+#include <algorithm>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+/**
+ * Golden output regression harness. Renders the test signals (see testsignals.h)
+ * through PluginProcess::process (for both single and double precision) across a
+ * set of parameter presets and compares the output against stored reference
+ * renders. Each preset defines an accuracy budget (minimum signal to error ratio
+ * and maximum absolute error) so optimized kernels (e.g. approximations or SIMD
+ * rewrites) can be validated against a measured accuracy rather than bit exactness.
+ *
+ * usage:
+ *
+ *   regression --generate [--reference-dir <dir>]  renders the reference files
+ *   regression [--reference-dir <dir>]             compares against the reference files
+ *
+ * optional: --filter <name> to only run the tests containing given name
+ *           --block-size <samples> to render in a different block size than the references
+ *           --random-block-size to render in varying block sizes (between 1 and twice the
+ *           block size, as some hosts do around loop points and automation changes)
+ *
+ * returns a non-zero exit code when a test exceeds its budget (or has no reference), when
+ * built with ENABLE_RT_SAFETY_CHECKS a test also fails when processing made realtime unsafe calls
+ */
+using namespace Igorski;
+
+static const float SAMPLE_RATE    = 44100.f;
+static const int   CHANNELS       = 2;
+static const int   RENDER_LENGTH  = 66150; // 1.5 seconds
+static const int   BLOCK_SIZE     = 512;
+
+static const char     REFERENCE_MAGIC[ 4 ] = { 'T', 'F', 'R', 'R' };
+static const uint32_t REFERENCE_VERSION    = 1;
+
+// a preset mirrors the plugin parameters (see Transformant::syncModel())
+
+struct Preset {
+    const char* name;
+    float vowelL;
+    float vowelR;
+    bool  vowelSync;
+    float lfoL;
+    float lfoLDepth;
+    float lfoR;
+    float lfoRDepth;
+    bool  distortionTypeCrusher;
+    float drive;
+    bool  distortionPostMix;
+    Quality::Tier quality;
+
+    // accuracy budget
+
+    double minSNR;   // in dB
+    double maxError; // absolute
+};
+
+// the budgets of the distortion presets are looser as the wave shaping amplifies
+// deviations and the bit crusher quantizes (where a minor deviation can flip a step)
+
+static const Preset PRESETS[] = {
+    { "static",     0.2f, 0.7f, false, 0.f,  0.f,  0.f,  0.f,  false, 0.f,  false, Quality::REALTIME, 100.0, 1e-4 },
+    { "lfo",        0.3f, 0.6f, false, 0.3f, 0.5f, 0.6f, 0.8f, false, 0.f,  false, Quality::REALTIME, 100.0, 1e-4 },
+    { "sync",       0.5f, 0.1f, true,  0.7f, 1.f,  0.f,  0.f,  false, 0.f,  false, Quality::REALTIME, 100.0, 1e-4 },
+    { "waveshaper", 0.4f, 0.8f, false, 0.2f, 0.4f, 0.4f, 0.3f, false, 0.6f, false, Quality::REALTIME,  80.0, 1e-3 },
+    { "crusher",    0.6f, 0.3f, false, 0.5f, 0.5f, 0.1f, 0.9f, true,  0.5f, true,  Quality::REALTIME,  40.0, 5e-2 },
+    { "offline",    0.4f, 0.8f, false, 0.2f, 0.4f, 0.4f, 0.3f, false, 0.6f, false, Quality::OFFLINE,   80.0, 1e-3 },
+};
+
+static const int PRESET_AMOUNT = sizeof( PRESETS ) / sizeof( Preset );
+
+struct Options {
+    bool generate             = false;
+    std::string referenceDir  = "reference";
+    const char* filter        = nullptr;
+    int blockSize             = BLOCK_SIZE;
+    bool randomBlockSize      = false;
+};
+
+static Options options;
+
+// returns the size of the next block to render. When rendering in random block sizes, the size is
+// determined by a fixed seed LCG so failures are reproducible, regularly mixing in very small blocks
+
+static int getNextBlockSize( uint32_t& seed )
+{
+    if ( !options.randomBlockSize ) {
+        return options.blockSize;
+    }
+    seed = seed * 1664525u + 1013904223u;
+
+    if (( seed >> 28 ) < 4 ) {
+        return 1 + ( int )(( seed >> 8 ) % 17 );
+    }
+    return 1 + ( int )(( seed >> 8 ) % ( uint32_t ) ( options.blockSize * 2 ));
+}
+
+static void applyPreset( PluginProcess* pluginProcess, const Preset& preset )
+{
+    pluginProcess->setQuality( preset.quality );
+
+    pluginProcess->distortionPostMix     = preset.distortionPostMix;
+    pluginProcess->distortionTypeCrusher = preset.distortionTypeCrusher;
+    pluginProcess->bitCrusher->setAmount( preset.drive );
+    pluginProcess->waveShaper->setAmount( preset.drive );
+    pluginProcess->vowelSync = preset.vowelSync;
+
+    for ( int c = 0; c < pluginProcess->getFormantFilterAmount(); ++c ) {
+        FormantFilter* formantFilter = pluginProcess->getFormantFilter( c );
+        bool left = c % 2 == 0 || preset.vowelSync;
+
+        formantFilter->setVowel( left ? preset.vowelL : preset.vowelR );
+        formantFilter->setLFO( left ? preset.lfoL : preset.lfoR, left ? preset.lfoLDepth : preset.lfoRDepth );
+    }
+}
+
+// renders given signal through a newly constructed PluginProcess configured for given
+// preset, the output is stored interleaved (in double precision for either sample type)
+
+template <typename SampleType>
+static void render( const Preset& preset, TestSignals::Type signal, std::vector<double>& output )
+{
+    int maxBlockSize = options.randomBlockSize ? options.blockSize * 2 : options.blockSize;
+    uint32_t seed    = 0x5EED;
+
+    PluginProcess* pluginProcess = new PluginProcess( CHANNELS, SAMPLE_RATE );
+    pluginProcess->reconfigure( SAMPLE_RATE, maxBlockSize, CHANNELS );
+    applyPreset( pluginProcess, preset );
+
+    std::vector<double> source( maxBlockSize );
+    std::vector<SampleType> buffers[ CHANNELS ];
+    SampleType* channels[ CHANNELS ];
+
+    for ( int c = 0; c < CHANNELS; ++c ) {
+        buffers[ c ].resize( maxBlockSize );
+        channels[ c ] = buffers[ c ].data();
+    }
+    output.resize(( size_t ) RENDER_LENGTH * CHANNELS );
+
+    for ( int offset = 0, size = 0; offset < RENDER_LENGTH; offset += size ) {
+        size = std::min( getNextBlockSize( seed ), RENDER_LENGTH - offset );
+
+        for ( int c = 0; c < CHANNELS; ++c ) {
+            TestSignals::generate( signal, source.data(), size, c, SAMPLE_RATE, offset );
+            for ( int i = 0; i < size; ++i ) {
+                channels[ c ][ i ] = ( SampleType ) source[ i ];
+            }
+        }
+
+        {
+            RT_SAFETY_SCOPE( true );
+            pluginProcess->process<SampleType>( channels, channels, CHANNELS, CHANNELS, size, size * sizeof( SampleType ));
+        }
+
+        for ( int c = 0; c < CHANNELS; ++c ) {
+            for ( int i = 0; i < size; ++i ) {
+                output[( size_t )( offset + i ) * CHANNELS + c ] = ( double ) channels[ c ][ i ];
+            }
+        }
+    }
+    delete pluginProcess;
+}
+
+/* reference file I/O */
+
+static std::string getReferencePath( const std::string& testName )
+{
+    return options.referenceDir + "/" + testName + ".ref";
+}
+
+static bool writeReference( const std::string& path, const std::vector<double>& samples )
+{
+    FILE* file = fopen( path.c_str(), "wb" );
+    if ( file == nullptr ) {
+        return false;
+    }
+    uint32_t channels = CHANNELS;
+    uint32_t frames   = ( uint32_t ) ( samples.size() / CHANNELS );
+
+    bool success = fwrite( REFERENCE_MAGIC, 1, 4, file ) == 4 &&
+                   fwrite( &REFERENCE_VERSION, sizeof( uint32_t ), 1, file ) == 1 &&
+                   fwrite( &channels, sizeof( uint32_t ), 1, file ) == 1 &&
+                   fwrite( &frames, sizeof( uint32_t ), 1, file ) == 1 &&
+                   fwrite( samples.data(), sizeof( double ), samples.size(), file ) == samples.size();
+
+    fclose( file );
+    return success;
+}
+
+static bool readReference( const std::string& path, std::vector<double>& samples )
+{
+    FILE* file = fopen( path.c_str(), "rb" );
+    if ( file == nullptr ) {
+        return false;
+    }
+    char magic[ 4 ];
+    uint32_t version  = 0;
+    uint32_t channels = 0;
+    uint32_t frames   = 0;
+
+    bool success = fread( magic, 1, 4, file ) == 4 && memcmp( magic, REFERENCE_MAGIC, 4 ) == 0 &&
+                   fread( &version, sizeof( uint32_t ), 1, file ) == 1 && version == REFERENCE_VERSION &&
+                   fread( &channels, sizeof( uint32_t ), 1, file ) == 1 && channels == CHANNELS &&
+                   fread( &frames, sizeof( uint32_t ), 1, file ) == 1;
+
+    if ( success ) {
+        samples.resize(( size_t ) frames * channels );
+        success = fread( samples.data(), sizeof( double ), samples.size(), file ) == samples.size();
+    }
+    fclose( file );
+    return success;
+}
+
+/* comparison */
+
+struct Comparison {
+    double snr;      // in dB (infinite when identical)
+    double maxError;
+    bool   hasNonFinite;
+};
+
+static Comparison compare( const std::vector<double>& output, const std::vector<double>& reference )
+{
+    Comparison result = { INFINITY, 0.0, false };
+
+    // non finite output fails the test regardless of the error (which it renders meaningless)
+
+    result.hasNonFinite = AudioBuffer::analyse( output.data(), ( int ) output.size()).hasNonFinite;
+
+    double signalEnergy = 0.0;
+    double errorEnergy  = 0.0;
+
+    for ( size_t i = 0; i < output.size(); ++i ) {
+        double error = fabs( output[ i ] - reference[ i ]);
+
+        signalEnergy += reference[ i ] * reference[ i ];
+        errorEnergy  += error * error;
+        result.maxError = std::max( result.maxError, error );
+    }
+
+    if ( errorEnergy > 0.0 ) {
+        result.snr = signalEnergy > 0.0 ? 10.0 * log10( signalEnergy / errorEnergy ) : -INFINITY;
+    }
+    return result;
+}
+
+/* test runner */
+
+// renders (and either stores or validates) a single test, returns whether it succeeded
+
+template <typename SampleType>
+static bool runTest( const Preset& preset, TestSignals::Type signal, const char* typeName )
+{
+    std::string testName = std::string( preset.name ) + "_" + TestSignals::NAMES[ signal ] + "_" + typeName;
+
+    if ( options.filter != nullptr && testName.find( options.filter ) == std::string::npos ) {
+        return true;
+    }
+
+    std::vector<double> output;
+
+#ifdef ENABLE_RT_SAFETY_CHECKS
+    uint64 violations = RTSafety::getViolations();
+    render<SampleType>( preset, signal, output );
+
+    if ( RTSafety::getViolations() != violations ) {
+        printf( "%-32s FAILED realtime unsafe calls while processing (see above)\n", testName.c_str());
+        return false;
+    }
+#else
+    render<SampleType>( preset, signal, output );
+#endif
+
+    std::string path = getReferencePath( testName );
+
+    if ( options.generate ) {
+        if ( !writeReference( path, output )) {
+            printf( "%-32s FAILED could not write %s\n", testName.c_str(), path.c_str());
+            return false;
+        }
+        printf( "%-32s written\n", testName.c_str());
+        return true;
+    }
+
+    std::vector<double> reference;
+    if ( !readReference( path, reference )) {
+        printf( "%-32s FAILED missing or invalid reference %s\n", testName.c_str(), path.c_str());
+        return false;
+    }
+    if ( reference.size() != output.size()) {
+        printf( "%-32s FAILED reference length mismatch\n", testName.c_str());
+        return false;
+    }
+
+    Comparison result = compare( output, reference );
+    bool success = !result.hasNonFinite && result.snr >= preset.minSNR && result.maxError <= preset.maxError;
+
+    printf( "%-32s %s SNR %7.1f dB (min %5.1f) max error %.3e (max %.0e)%s\n", testName.c_str(),
+        success ? "ok    " : "FAILED", result.snr, preset.minSNR, result.maxError, preset.maxError,
+        result.hasNonFinite ? " non-finite output" : ""
+    );
+    return success;
+}
+
+int main( int argc, char** argv )
+{
+    for ( int i = 1; i < argc; ++i ) {
+        if ( strcmp( argv[ i ], "--generate" ) == 0 ) {
+            options.generate = true;
+        } else if ( strcmp( argv[ i ], "--reference-dir" ) == 0 && i + 1 < argc ) {
+            options.referenceDir = argv[ ++i ];
+        } else if ( strcmp( argv[ i ], "--filter" ) == 0 && i + 1 < argc ) {
+            options.filter = argv[ ++i ];
+        } else if ( strcmp( argv[ i ], "--block-size" ) == 0 && i + 1 < argc ) {
+            options.blockSize = atoi( argv[ ++i ]);
+        } else if ( strcmp( argv[ i ], "--random-block-size" ) == 0 ) {
+            options.randomBlockSize = true;
+        } else {
+            printf( "usage: %s [--generate] [--reference-dir <dir>] [--filter <name>] [--block-size <samples>] [--random-block-size]\n", argv[ 0 ]);
+            return 1;
+        }
+    }
+
+    if ( options.blockSize < 1 ) {
+        printf( "block size must be positive\n" );
+        return 1;
+    }
+
+    if ( options.generate && options.randomBlockSize ) {
+        printf( "references are rendered in a fixed block size, omit --random-block-size\n" );
+        return 1;
+    }
+
+    int failures = 0;
+    int tests    = 0;
+
+    for ( int p = 0; p < PRESET_AMOUNT; ++p ) {
+        for ( int s = 0; s < TestSignals::AMOUNT; ++s ) {
+            TestSignals::Type signal = ( TestSignals::Type ) s;
+
+            failures += runTest<float>( PRESETS[ p ], signal, "float" ) ? 0 : 1;
+            failures += runTest<double>( PRESETS[ p ], signal, "double" ) ? 0 : 1;
+            tests    += 2;
+        }
+    }
+
+    printf( "\n%d of %d tests %s\n", tests - failures, tests, options.generate ? "written" : "within budget" );
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "testsignals.h"
+#include <math.h>
+#include <stdint.h>
+
+namespace Igorski {
+namespace TestSignals {
+
+const char* NAMES[ AMOUNT ] = { "sweep", "noise", "impulses", "speech" };
+
+static const double TWO_PI = 6.283185307179586;
+
+// length (in seconds) of a single sweep, after which it repeats
+
+static const double SWEEP_DURATION = 1.0;
+
+// returns a uniformly distributed value in the -1 to +1 range for given position
+// (a hash rather than a stateful generator, so any offset can be generated directly)
+
+static double noiseAt( int64_t position, int channel )
+{
+    uint32_t x = ( uint32_t ) position * 0x9E3779B1u + ( uint32_t ) channel * 0x85EBCA77u + 0x165667B1u;
+    x ^= x >> 15;
+    x *= 0x2C1B3C6Du;
+    x ^= x >> 12;
+    x *= 0x297A2D39u;
+    x ^= x >> 15;
+
+    return (( double ) x / 2147483647.5 ) - 1.0;
+}
+
+void generate( Type type, double* buffer, int length, int channel, float sampleRate, int offset )
+{
+    const double sr = ( double ) sampleRate;
+
+    for ( int i = 0; i < length; ++i ) {
+        const int64_t position = ( int64_t ) offset + i;
+        const double time      = ( double ) position / sr;
+        double sample = 0.0;
+
+        switch ( type ) {
+            default:
+            case SINE_SWEEP: {
+                // the phase of an exponential sweep is the integral of its frequency
+
+                const double startFrequency = 20.0 * ( 1.0 + channel * 0.05 );
+                const double ratio = log( 20000.0 / startFrequency );
+                const double t     = fmod( time, SWEEP_DURATION );
+                const double phase = TWO_PI * startFrequency * SWEEP_DURATION / ratio * ( exp( t / SWEEP_DURATION * ratio ) - 1.0 );
+                sample = sin( phase ) * 0.5;
+                break;
+            }
+            case NOISE:
+                sample = noiseAt( position, channel ) * 0.5;
+                break;
+
+            case IMPULSES: {
+                const int64_t interval = ( int64_t ) ( sr * 0.1 );
+                sample = (( position + channel * 7 ) % interval ) == 0 ? 0.9 : 0.0;
+                break;
+            }
+            case SPEECH: {
+                // glottal pulses (decaying per pitch period) with a slow pitch contour
+                // gated into syllables of 150 ms followed by 50 ms of silence
+
+                const double syllable = fmod( time, 0.2 );
+                if ( syllable >= 0.15 ) {
+                    break;
+                }
+                const double pitch    = ( channel % 2 == 0 ? 120.0 : 180.0 ) * ( 1.0 + 0.1 * sin( TWO_PI * 3.0 * time ));
+                const double period   = fmod( syllable * pitch, 1.0 );
+                const double envelope = sin( syllable / 0.15 * TWO_PI * 0.5 );
+
+                sample = ( exp( -period * 8.0 ) - 0.125 ) * envelope * 0.7 + noiseAt( position, channel ) * envelope * 0.02;
+                break;
+            }
+        }
+        buffer[ i ] = sample;
+    }
+}
+
+}
+}
@@ -0,0 +1,54 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __TESTSIGNALS_H_INCLUDED__
+#define __TESTSIGNALS_H_INCLUDED__
+
+/**
+ * Deterministic test signals used by the benchmark and regression tools. The
+ * generated signals only depend on their arguments (e.g. the noise uses its own
+ * seeded generator) so renders are reproducible across runs and platforms.
+ */
+namespace Igorski {
+namespace TestSignals {
+
+    enum Type {
+        SINE_SWEEP = 0, // exponential sine sweep from 20 Hz to 20 kHz
+        NOISE,          // white noise
+        IMPULSES,       // unit impulses at 100 ms intervals
+        SPEECH,         // speech-like glottal pulse train, gated into syllables
+        AMOUNT
+    };
+
+    extern const char* NAMES[ AMOUNT ];
+
+    // fills given buffer with length samples of given signal type. Each channel
+    // yields a slightly different signal (to exercise non dual mono processing)
+    // offset specifies the position (in samples) within the signal, allowing
+    // it to be generated in consecutive blocks
+
+    void generate( Type type, double* buffer, int length, int channel, float sampleRate, int offset = 0 );
+
+}
+}
+
+#endif
@@ -0,0 +1,74 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __ALIGNEDMEMORY_H_INCLUDED__
+#define __ALIGNEDMEMORY_H_INCLUDED__
+
+#include <stdlib.h>
+#include <stddef.h>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+/**
+ * convenience methods to allocate memory that starts at a cache line
+ * boundary (which is also suitable for SIMD loads and stores)
+ * memory allocated with AlignedMemory::allocate() must be released using AlignedMemory::free()
+ */
+namespace Igorski {
+namespace AlignedMemory {
+
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    // rounds given size in bytes up to the nearest multiple of the cache line size
+
+    inline size_t pad( size_t size )
+    {
+        return ( size + CACHE_LINE_SIZE - 1 ) & ~( CACHE_LINE_SIZE - 1 );
+    }
+
+    inline void* allocate( size_t size )
+    {
+        size = pad( size == 0 ? 1 : size );
+    #ifdef _WIN32
+        return _aligned_malloc( size, CACHE_LINE_SIZE );
+    #else
+        void* memory = nullptr;
+        if ( posix_memalign( &memory, CACHE_LINE_SIZE, size ) != 0 ) {
+            return nullptr;
+        }
+        return memory;
+    #endif
+    }
+
+    inline void free( void* memory )
+    {
+    #ifdef _WIN32
+        _aligned_free( memory );
+    #else
+        ::free( memory );
+    #endif
+    }
+}
+}
+
+#endif
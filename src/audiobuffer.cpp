@@ -21,45 +21,49 @@
  * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "audiobuffer.h"
+#include "alignedmemory.h"
 #include <algorithm>
+#include <new>
 #include <string.h>
+#include <math.h>
+
+using namespace Igorski;
 
 AudioBuffer::AudioBuffer( int aAmountOfChannels, int aBufferSize )
 {
     loopeable        = false;
     amountOfChannels = aAmountOfChannels;
     bufferSize       = aBufferSize;
+    stride           = ( int ) ( AlignedMemory::pad( aBufferSize * sizeof( double )) / sizeof( double ));
 
-    // create silent buffers for each channel
+    // create a single allocation holding all channels
 
-    _buffers = new std::vector<double*>( amountOfChannels );
+    size_t size = ( size_t ) amountOfChannels * stride * sizeof( double );
+    _data = ( double* ) AlignedMemory::allocate( size );
 
-    // fill buffers with silence
+    // fail the same way a regular allocation would
 
-    for ( int i = 0; i < amountOfChannels; ++i ) {
-        _buffers->at( i ) = new double[ aBufferSize ];
-        memset( _buffers->at( i ), 0, aBufferSize * sizeof( double )); // zero bits should equal 0.f
+    if ( _data == nullptr ) {
+        throw std::bad_alloc();
     }
+
+    // fill buffers (including their padding) with silence
+
+    memset( _data, 0, size ); // zero bits should equal 0.f
 }
 
 AudioBuffer::~AudioBuffer()
 {
-    while ( !_buffers->empty()) {
-        delete[] _buffers->back(), _buffers->pop_back();
-    }
-    delete _buffers;
+    AlignedMemory::free( _data );
 }
 
 /* public methods */
 
-double* AudioBuffer::getBufferForChannel( int aChannelNum )
-{
-    return _buffers->at( aChannelNum );
-}
-
 int AudioBuffer::mergeBuffers( AudioBuffer* aBuffer, int aReadOffset, int aWriteOffset, float aMixVolume )
 {
-    if ( aBuffer == 0 || aWriteOffset >= bufferSize )
+    // merging a buffer into itself is not supported as the mixed ranges may overlap (see mix())
+
+    if ( aBuffer == 0 || aBuffer == this || aWriteOffset >= bufferSize )
         return 0;
 
     int sourceLength     = aBuffer->bufferSize;
@@ -83,17 +87,28 @@ int AudioBuffer::mergeBuffers( AudioBuffer* aBuffer, int aReadOffset, int aWrite
         auto srcBuffer    = aBuffer->getBufferForChannel( c );
         auto targetBuffer = getBufferForChannel( c );
 
-        for ( int i = aWriteOffset, r = aReadOffset; i < maxWriteOffset; ++i, ++r )
+        // rather than checking for the end of the source on each sample, the write is split
+        // into segments that end where the source ends (or wraps, in case the source is loopeable)
+
+        int i = aWriteOffset;
+        int r = aReadOffset;
+
+        while ( i < maxWriteOffset )
         {
             if ( r >= sourceLength )
             {
-                if ( aBuffer->loopeable )
+                if ( aBuffer->loopeable && sourceLength > 0 )
                     r = 0;
                 else
                     break;
             }
-            targetBuffer[ i ] += ( srcBuffer[ r ] * aMixVolume );
-            ++writtenSamples;
+            int segmentLength = std::min( maxWriteOffset - i, sourceLength - r );
+
+            mix( targetBuffer + i, srcBuffer + r, segmentLength, aMixVolume );
+
+            i += segmentLength;
+            r += segmentLength;
+            writtenSamples += segmentLength;
         }
     }
     // return the amount of samples written (per buffer)
@@ -107,45 +122,68 @@ int AudioBuffer::mergeBuffers( AudioBuffer* aBuffer, int aReadOffset, int aWrite
 void AudioBuffer::silenceBuffers()
 {
     // use mem set to quickly erase existing buffer contents, zero bits should equal 0.f
-    for ( int i = 0; i < amountOfChannels; ++i )
-        memset( getBufferForChannel( i ), 0, bufferSize * sizeof( double ));
+    // as the channels are contiguous, this clears all channels at once
+    memset( _data, 0, ( size_t ) amountOfChannels * stride * sizeof( double ));
 }
 
 void AudioBuffer::adjustBufferVolumes( float amp )
 {
+    double volume = ( double ) amp;
+
     for ( int i = 0; i < amountOfChannels; ++i )
     {
-        auto buffer = getBufferForChannel( i );
+        double* SIMD_RESTRICT buffer = getBufferForChannel( i );
 
         for ( int j = 0; j < bufferSize; ++j )
-            buffer[ j ] *= amp;
+            buffer[ j ] *= volume;
     }
 }
 
 bool AudioBuffer::isSilent()
 {
+    // the channels are inspected in blocks without branching (allowing vectorization)
+    // we only return early in between blocks
+
     for ( int i = 0; i < amountOfChannels; ++i )
     {
-        auto buffer = getBufferForChannel( i );
-        for ( int j = 0; j < bufferSize; ++j )
+        const double* buffer = getBufferForChannel( i );
+
+        for ( int offset = 0; offset < bufferSize; offset += SCAN_BLOCK_SIZE )
         {
-            if ( buffer[ j ] != 0.f )
+            int length      = std::min( SCAN_BLOCK_SIZE, bufferSize - offset );
+            double hasSound = 0.0; // kept as a double (rather than bool) for the compiler to vectorize
+
+            for ( int j = 0; j < length; ++j )
+                hasSound = ( buffer[ offset + j ] != 0.0 ) ? 1.0 : hasSound;
+
+            if ( hasSound != 0.0 )
                 return false;
         }
     }
     return true;
 }
 
+AudioBuffer::Analysis AudioBuffer::analyse( int aChannelNum )
+{
+    return analyse( getBufferForChannel( aChannelNum ), bufferSize );
+}
+
 AudioBuffer* AudioBuffer::clone()
 {
     AudioBuffer* output = new AudioBuffer( amountOfChannels, bufferSize );
 
-    for ( int i = 0; i < amountOfChannels; ++i )
-    {
-        auto sourceBuffer = getBufferForChannel( i );
-        auto targetBuffer = output->getBufferForChannel( i );
+    // as both buffers share the same layout, all channels can be copied at once
+    memcpy( output->_data, _data, ( size_t ) amountOfChannels * stride * sizeof( double ));
 
-        memcpy( targetBuffer, sourceBuffer, bufferSize * sizeof( double ));
-    }
     return output;
 }
+
+/* protected methods */
+
+void AudioBuffer::mix( double* SIMD_RESTRICT target, const double* SIMD_RESTRICT source, int length, float volume )
+{
+    double mixVolume = ( double ) volume;
+
+    for ( int i = 0; i < length; ++i )
+        target[ i ] += ( source[ i ] * mixVolume );
+}
@@ -24,15 +24,36 @@
 #define __AUDIOBUFFER_H_INCLUDED__
 
 #include "global.h"
-#include <vector>
+#include <stddef.h>
+#include <algorithm>
+#include <math.h>
+
+// hints the compiler that pointers do not alias (allowing the loops using them to be vectorized)
+
+#if defined( _MSC_VER )
+#define SIMD_RESTRICT __restrict
+#else
+#define SIMD_RESTRICT __restrict__
+#endif
 
 /**
  * An AudioBuffer represents multiple channels of audio
  * each of equal buffer length.
  * AudioBuffer has convenience methods for cloning, silencing and mixing
+ *
+ * All channels are stored in a single allocation, where each channel starts
+ * at a cache line boundary (the distance between channels is given by stride)
  */
 class AudioBuffer
 {
+    // size of the blocks in which the silence detection can return early
+
+    static constexpr int SCAN_BLOCK_SIZE = 64;
+
+    // amount of independent accumulators used by the analysis
+
+    static const int ANALYSIS_LANES = 4;
+
     public:
         AudioBuffer( int aAmountOfChannels, int aBufferSize );
         ~AudioBuffer();
@@ -41,15 +62,55 @@ class AudioBuffer
         int bufferSize;
         bool loopeable;
 
-        double* getBufferForChannel( int aChannelNum );
+        // distance (in samples) between the start of consecutive channels
+        // this equals bufferSize padded to a multiple of the cache line size
+
+        int stride;
+
+        // note the accessors are unchecked, aChannelNum must be within the amountOfChannels range
+
+        inline double* getBufferForChannel( int aChannelNum )
+        {
+            return _data + ( size_t ) aChannelNum * stride;
+        }
+
+        // mixes given buffer into this buffer, where given buffer cannot be this buffer itself
+        // returns the amount of samples written (per channel)
+
         int mergeBuffers( AudioBuffer* aBuffer, int aReadOffset, int aWriteOffset, float aMixVolume );
         void silenceBuffers();
         void adjustBufferVolumes( float volume );
         bool isSilent();
         AudioBuffer* clone();
 
+        // the peak, RMS and presence of non finite (NaN or infinite) values
+        // of a single channel, calculated in a single pass
+
+        struct Analysis {
+            double peak;
+            double rms;
+            bool hasNonFinite;
+
+            inline bool isSilent() const {
+                return peak == 0.0 && !hasNonFinite;
+            }
+        };
+
+        Analysis analyse( int aChannelNum );
+
+        // analyses the contents of given (e.g. the hosts float or double) buffer
+
+        template <typename SampleType>
+        static Analysis analyse( const SampleType* buffer, int length );
+
     protected:
-        std::vector<double*>* _buffers;
+        double* _data;
+
+        // target and source must not overlap
+
+        static void mix( double* SIMD_RESTRICT target, const double* SIMD_RESTRICT source, int length, float volume );
 };
 
+#include "audiobuffer.tcc"
+
 #endif
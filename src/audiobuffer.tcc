@@ -0,0 +1,74 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+template <typename SampleType>
+AudioBuffer::Analysis AudioBuffer::analyse( const SampleType* buffer, int length )
+{
+    // the calculation is spread over multiple independent accumulators (lanes) so
+    // the compiler can vectorize it without requiring relaxed floating point math
+
+    SampleType peaks[ ANALYSIS_LANES ]   = { 0 };
+    double     squares[ ANALYSIS_LANES ] = { 0.0 };
+    SampleType invalid[ ANALYSIS_LANES ] = { 0 }; // sample * 0 is only non-zero (NaN) for non finite samples
+
+    int blockLength = length - ( length % ANALYSIS_LANES );
+
+    for ( int i = 0; i < blockLength; i += ANALYSIS_LANES )
+    {
+        for ( int l = 0; l < ANALYSIS_LANES; ++l )
+        {
+            SampleType sample = buffer[ i + l ];
+            SampleType abs    = sample < 0 ? -sample : sample;
+
+            peaks[ l ]    = abs > peaks[ l ] ? abs : peaks[ l ];
+            squares[ l ] += ( double ) sample * ( double ) sample;
+            invalid[ l ] += sample * 0;
+        }
+    }
+
+    // remaining samples
+
+    for ( int i = blockLength; i < length; ++i )
+    {
+        SampleType sample = buffer[ i ];
+        SampleType abs    = sample < 0 ? -sample : sample;
+
+        peaks[ 0 ]    = abs > peaks[ 0 ] ? abs : peaks[ 0 ];
+        squares[ 0 ] += ( double ) sample * ( double ) sample;
+        invalid[ 0 ] += sample * 0;
+    }
+
+    Analysis analysis = { 0.0, 0.0, false };
+    double sum = 0.0;
+
+    for ( int l = 0; l < ANALYSIS_LANES; ++l )
+    {
+        analysis.peak = std::max( analysis.peak, ( double ) peaks[ l ]);
+        sum += squares[ l ];
+
+        if ( invalid[ l ] != 0 || invalid[ l ] != invalid[ l ] )
+            analysis.hasNonFinite = true;
+    }
+    analysis.rms = ( length > 0 ) ? sqrt( sum / length ) : 0.0;
+
+    return analysis;
+}
@@ -0,0 +1,104 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "bufferpool.h"
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+BufferPool::BufferPool( int capacity, int amountOfChannels, int bufferSize )
+{
+    _capacity         = capacity;
+    _availableAmount  = capacity;
+    _highWaterMark    = 0;
+    _amountOfChannels = amountOfChannels;
+    _bufferSize       = bufferSize;
+
+    _buffers   = new AudioBuffer*[ _capacity ];
+    _available = new AudioBuffer*[ _capacity ];
+
+    for ( int i = 0; i < _capacity; ++i ) {
+        _buffers[ i ]   = new AudioBuffer( _amountOfChannels, _bufferSize );
+        _available[ i ] = _buffers[ i ];
+    }
+}
+
+BufferPool::~BufferPool()
+{
+    for ( int i = 0; i < _capacity; ++i ) {
+        delete _buffers[ i ];
+    }
+    delete[] _buffers;
+    delete[] _available;
+}
+
+/* public methods */
+
+AudioBuffer* BufferPool::checkout()
+{
+    if ( _availableAmount == 0 ) {
+        return nullptr;
+    }
+    AudioBuffer* buffer = _available[ --_availableAmount ];
+
+    int checkedOut = _capacity - _availableAmount;
+    if ( checkedOut > _highWaterMark ) {
+        _highWaterMark = checkedOut;
+    }
+    return buffer;
+}
+
+void BufferPool::release( AudioBuffer* buffer )
+{
+    if ( buffer == nullptr || _availableAmount == _capacity ) {
+        return;
+    }
+    _available[ _availableAmount++ ] = buffer;
+}
+
+int BufferPool::getCapacity()
+{
+    return _capacity;
+}
+
+int BufferPool::getAvailable()
+{
+    return _availableAmount;
+}
+
+int BufferPool::getAmountOfChannels()
+{
+    return _amountOfChannels;
+}
+
+int BufferPool::getBufferSize()
+{
+    return _bufferSize;
+}
+
+int BufferPool::getHighWaterMark()
+{
+    return _highWaterMark;
+}
+
+}
@@ -0,0 +1,76 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __BUFFERPOOL_H_INCLUDED__
+#define __BUFFERPOOL_H_INCLUDED__
+
+#include "audiobuffer.h"
+
+namespace Igorski {
+
+/**
+ * BufferPool holds a fixed amount of preallocated AudioBuffers of equal
+ * dimensions, which can be checked out and released in constant time
+ * without allocating memory, making it suitable for providing scratch
+ * space (e.g. for oversampling or dry signal copies) on the audio thread.
+ *
+ * All allocation happens upon construction, which should not happen on the audio
+ * thread. Checking out and releasing buffers is not thread safe, buffers should be
+ * checked out by the audio thread (and can then be handed to worker threads).
+ */
+class BufferPool
+{
+    public:
+        BufferPool( int capacity, int amountOfChannels, int bufferSize );
+        ~BufferPool();
+
+        // retrieves an available buffer, nullptr when all buffers are checked out
+        // note the contents of the buffer are those left by its previous user
+
+        AudioBuffer* checkout();
+
+        // returns a previously checked out buffer to the pool
+
+        void release( AudioBuffer* buffer );
+
+        int getCapacity();
+        int getAvailable();
+        int getAmountOfChannels();
+        int getBufferSize();
+
+        // the highest amount of buffers that were checked out simultaneously (for debugging
+        // purposes, e.g. to determine whether the capacity is appropriate for the use case)
+
+        int getHighWaterMark();
+
+    private:
+        AudioBuffer** _buffers;   // all buffers owned by this pool
+        AudioBuffer** _available; // stack of buffers that are available for checkout
+        int _capacity;
+        int _availableAmount;
+        int _highWaterMark;
+        int _amountOfChannels;
+        int _bufferSize;
+};
+}
+
+#endif
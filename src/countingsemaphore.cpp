@@ -0,0 +1,82 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "countingsemaphore.h"
+#include <errno.h>
+#include <limits.h>
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+CountingSemaphore::CountingSemaphore()
+{
+#ifdef _WIN32
+    _semaphore = CreateSemaphore( nullptr, 0, LONG_MAX, nullptr );
+#elif defined( __APPLE__ )
+    _semaphore = dispatch_semaphore_create( 0 );
+#else
+    sem_init( &_semaphore, 0, 0 );
+#endif
+}
+
+CountingSemaphore::~CountingSemaphore()
+{
+#ifdef _WIN32
+    CloseHandle( _semaphore );
+#elif defined( __APPLE__ )
+    dispatch_release( _semaphore );
+#else
+    sem_destroy( &_semaphore );
+#endif
+}
+
+/* public methods */
+
+void CountingSemaphore::post( int amount )
+{
+#ifdef _WIN32
+    ReleaseSemaphore( _semaphore, amount, nullptr );
+#else
+    for ( int i = 0; i < amount; ++i ) {
+    #ifdef __APPLE__
+        dispatch_semaphore_signal( _semaphore );
+    #else
+        sem_post( &_semaphore );
+    #endif
+    }
+#endif
+}
+
+void CountingSemaphore::wait()
+{
+#ifdef _WIN32
+    WaitForSingleObject( _semaphore, INFINITE );
+#elif defined( __APPLE__ )
+    dispatch_semaphore_wait( _semaphore, DISPATCH_TIME_FOREVER );
+#else
+    // retry when interrupted by a signal
+    while ( sem_wait( &_semaphore ) != 0 && errno == EINTR ) {}
+#endif
+}
+
+}
@@ -0,0 +1,68 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __COUNTINGSEMAPHORE_H_INCLUDED__
+#define __COUNTINGSEMAPHORE_H_INCLUDED__
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined( __APPLE__ )
+#include <dispatch/dispatch.h>
+#else
+#include <semaphore.h>
+#endif
+
+namespace Igorski {
+
+/**
+ * CountingSemaphore wraps the native counting semaphore of the platform.
+ *
+ * Unlike a mutex and condition variable, posting does not require a lock to be
+ * acquired (nor does the posting thread wait for the waiting threads) and is thus
+ * safe to use on the audio thread to wake other threads.
+ */
+class CountingSemaphore
+{
+    public:
+        CountingSemaphore();
+        ~CountingSemaphore();
+
+        // increments the count by given amount, waking up as many waiting threads
+
+        void post( int amount = 1 );
+
+        // waits until the count is positive, decrementing it
+
+        void wait();
+
+    private:
+#ifdef _WIN32
+        HANDLE _semaphore;
+#elif defined( __APPLE__ )
+        dispatch_semaphore_t _semaphore;
+#else
+        sem_t _semaphore;
+#endif
+};
+}
+
+#endif
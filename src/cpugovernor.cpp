@@ -0,0 +1,108 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "cpugovernor.h"
+#include "calc.h"
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+CpuGovernor::CpuGovernor()
+{
+    _budget = DEFAULT_BUDGET;
+
+    setMaximumTier( Quality::REALTIME );
+}
+
+CpuGovernor::~CpuGovernor()
+{
+
+}
+
+/* public methods */
+
+void CpuGovernor::setBudget( float budget )
+{
+    _budget = Calc::cap( budget );
+}
+
+float CpuGovernor::getBudget()
+{
+    return _budget;
+}
+
+void CpuGovernor::setMaximumTier( Quality::Tier tier )
+{
+    _maximumTier  = tier;
+    _tier         = tier;
+    _overruns     = 0;
+    _headroomTime = 0.0;
+}
+
+Quality::Tier CpuGovernor::update( double processingTime, int numSamples, float sampleRate )
+{
+    if ( numSamples <= 0 || sampleRate <= 0.f ) {
+        return _tier;
+    }
+    double deadline = ( double ) numSamples / ( double ) sampleRate;
+    double load     = processingTime / deadline;
+
+    if ( load > _budget ) {
+        _headroomTime = 0.0;
+
+        if ( ++_overruns >= OVERRUN_THRESHOLD ) {
+            _overruns = 0;
+
+            if ( _tier > Quality::LOW ) {
+                _tier = ( Quality::Tier )( _tier - 1 );
+            }
+        }
+        return _tier;
+    }
+
+    if ( _overruns > 0 ) {
+        --_overruns;
+    }
+
+    // step up once the load has remained well below the budget for a while
+    // (the gap between the budget and the recovery share prevents oscillating between tiers)
+
+    if ( load < _budget * RECOVERY_SHARE ) {
+        _headroomTime += deadline;
+
+        if ( _headroomTime >= RECOVERY_TIME && _tier < _maximumTier ) {
+            _tier         = ( Quality::Tier )( _tier + 1 );
+            _headroomTime = 0.0;
+        }
+    } else {
+        _headroomTime = 0.0;
+    }
+    return _tier;
+}
+
+Quality::Tier CpuGovernor::getTier()
+{
+    return _tier;
+}
+
+}
@@ -0,0 +1,93 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __CPUGOVERNOR_H_INCLUDED__
+#define __CPUGOVERNOR_H_INCLUDED__
+
+#include "quality.h"
+
+namespace Igorski {
+
+/**
+ * CpuGovernor keeps track of the time spent processing each block relative to
+ * the blocks realtime deadline (e.g. its duration). When the processing time
+ * repeatedly exceeds the configured share of the deadline, the quality tier is
+ * stepped down. Once there is sufficient headroom for a sustained period, the
+ * quality is stepped back up (up to the maximum tier).
+ *
+ * The budget applies to a single instance, where the deadline is shared by all
+ * instances in the session. As the processing time is measured in wall clock time,
+ * it also grows when the session contends for the CPU (e.g. when the processing
+ * thread is preempted or the caches are shared with other instances)
+ */
+class CpuGovernor
+{
+    // amount of blocks exceeding the budget before stepping down. In budget blocks
+    // decrement the count, so only repeated overruns result in a lower quality
+
+    static const int OVERRUN_THRESHOLD = 4;
+
+    // the share of the budget below which there is considered to be headroom and the
+    // duration (in seconds) of uninterrupted headroom before stepping up again. The share
+    // is below the relative cost of the low tier (see quality.h) so stepping down doesn't
+    // by itself lead to stepping up again (alternating between tiers under constant load)
+
+    static constexpr float  RECOVERY_SHARE = 0.25f;
+    static constexpr double RECOVERY_TIME  = 2.0;
+
+    public:
+        // share of the deadline that may be used for processing by default. A stereo instance
+        // at the realtime tier uses a few percent of the deadline on current hardware, this
+        // is exceeded when the session contends for the CPU (see above)
+
+        static constexpr float DEFAULT_BUDGET = 0.1f;
+
+        CpuGovernor();
+        ~CpuGovernor();
+
+        // the share (in 0 - 1 range) of the blocks deadline that may be spent processing
+
+        void setBudget( float budget );
+        float getBudget();
+
+        // the highest tier the governor may select (e.g. the tier for the hosts process mode)
+        // this resets the governor to given tier
+
+        void setMaximumTier( Quality::Tier tier );
+
+        // registers the time (in seconds) spent processing a block of given size
+        // returns the tier that should be used for the next block
+
+        Quality::Tier update( double processingTime, int numSamples, float sampleRate );
+
+        Quality::Tier getTier();
+
+    private:
+        Quality::Tier _maximumTier;
+        Quality::Tier _tier;
+        float  _budget;
+        int    _overruns;
+        double _headroomTime; // duration of the uninterrupted headroom, in seconds
+};
+}
+
+#endif
@@ -27,22 +27,37 @@
 
 namespace Igorski {
 
+double FormantFilter::FORMANT_TABLE[ FORMANT_TABLE_SIZE * MAX_FORMANT_WIDTH ];
+
 /* constructor / destructor */
 
-FormantFilter::FormantFilter( float aVowel, float sampleRate )
+FormantFilter::FormantFilter( float aVowel, float sampleRate ) : lfo( sampleRate )
 {
-    double coeff = 2.0 / ( FORMANT_TABLE_SIZE - 1 );
-
-    for ( size_t i = 0; i < MAX_FORMANT_WIDTH; i++ )
-    {
-        for ( size_t j = 0; j < FORMANT_TABLE_SIZE; j++ ) {
-            FORMANT_TABLE[ j + i * FORMANT_TABLE_SIZE ] = generateFormant( -1 + j * coeff, double( i ));
-        }
-    }
+    // thread safe, one time generation of the shared formant table
+    [[maybe_unused]] static bool hasFormantTable = generateFormantTable();
 
     _sampleRate         = sampleRate;
     _halfSampleRateFrac = 1.f / ( _sampleRate * 0.5f );
 
+    hasLFO     = false;
+    _tempVowel = 0.0;
+    _lfoDepth  = 0.f;
+
+    _controlRate    = 1;
+    _controlCounter = 0;
+    _fp             = 0.0;
+    _ufp            = 0.0;
+    _phaseAcc       = 0.0;
+
+    _synthesisRate    = 1;
+    _synthesisCounter = 0;
+    _modulation       = 0.0;
+    _modulationStep   = 0.0;
+
+    _dEnv     = 0.0;
+    _dEnv2    = 0.0;
+    _dGainEnv = 0.0;
+
     setVowel( aVowel );
     cacheDynamicsProcessing();
 
@@ -50,22 +65,46 @@ FormantFilter::FormantFilter( float aVowel, float sampleRate )
     // when we want the audible oscillation of vowels to stop, the LFO
     // depth is merely at 0
 
-    lfo = new LFO( _sampleRate );
     setLFO( 0.f, 0.f );
 }
 
 FormantFilter::~FormantFilter()
 {
-    delete lfo;
+
 }
 
 /* public methods */
 
+void FormantFilter::setSampleRate( float sampleRate )
+{
+    _sampleRate         = sampleRate;
+    _halfSampleRateFrac = 1.f / ( _sampleRate * 0.5f );
+
+    lfo.setSampleRate( _sampleRate );
+
+    // recalculate the phase increment for the new rate upon the next sample
+    _controlCounter = 0;
+}
+
 float FormantFilter::getVowel()
 {
     return ( float ) _vowel;
 }
 
+float FormantFilter::getCurrentVowel()
+{
+    return ( float ) _tempVowel;
+}
+
+void FormantFilter::getFormants( float* frequencies, float* amplitudes )
+{
+    for ( size_t j = 0; j < VOWEL_AMOUNT; ++j )
+    {
+        frequencies[ j ] = ( float ) F_COEFFICIENTS[ j ].value;
+        amplitudes[ j ]  = ( float ) A_COEFFICIENTS[ j ].value;
+    }
+}
+
 void FormantFilter::setVowel( float aVowel )
 {
     _vowel = ( double ) aVowel;
@@ -87,7 +126,7 @@ void FormantFilter::setLFO( float LFORatePercentage, float LFODepth )
 
     hasLFO = isLFOenabled;
 
-    lfo->setRate(
+    lfo.setRate(
         VST::MIN_LFO_RATE() + (
             LFORatePercentage * ( VST::MAX_LFO_RATE() - VST::MIN_LFO_RATE() )
         )
@@ -99,34 +138,50 @@ void FormantFilter::setLFO( float LFORatePercentage, float LFODepth )
     }
 }
 
+void FormantFilter::setControlRate( int controlRate )
+{
+    _controlRate    = std::max( 1, controlRate );
+    _controlCounter = std::min( _controlCounter, _controlRate );
+}
+
+void FormantFilter::setSynthesisRate( int synthesisRate )
+{
+    _synthesisRate    = std::max( 1, synthesisRate );
+    _synthesisCounter = 0;
+    _modulationStep   = 0.0;
+}
+
 void FormantFilter::process( double* inBuffer, int bufferSize )
 {
-    float lfoValue;
-    double in, out, fp, ufp, phaseAcc, formant, carrier;
+    double modulation[ MODULATION_BLOCK ];
 
-    for ( size_t i = 0; i < bufferSize; ++i )
+    for ( int offset = 0; offset < bufferSize; offset += MODULATION_BLOCK )
     {
-        in  = inBuffer[ i ];
-        out = 0.0;
+        int size = std::min( MODULATION_BLOCK, bufferSize - offset );
 
-        // sweep the LFO
-
-        lfoValue   = lfo->peek() * .5f  + .5f; // make waveform unipolar
-        _tempVowel = std::min( _lfoMax, _lfoMin + _lfoRange * lfoValue ); // relative to LFO depth
+        modulate( modulation, size );
+        apply( inBuffer + offset, modulation, size );
+    }
+}
 
-        cacheCoeffOffset(); // ensure the appropriate coeff is used for the new _tempVowel value
+void FormantFilter::modulate( double* modulationBuffer, int bufferSize )
+{
+    for ( int i = 0; i < bufferSize; ++i )
+    {
+        // sweep the LFO and vowel (at the control rate)
 
-        // calculate the phase for the formant synthesis and carrier
+        if ( _controlCounter == 0 ) {
+            sweep();
+            _controlCounter = _controlRate;
+        }
+        --_controlCounter;
 
-        fp  = 12 * powf( 2.0, 4 - 4 * _tempVowel );   // sweep
-        // fp *= ( 1.0 + 0.01 * sinf( tmp * 0.0015 )); // optional vibrato (sinf value determines speed)
-        ufp = 1.0 / fp;
+        // advance the phase for the formant synthesis and carrier
 
-        phaseAcc = fp * _halfSampleRateFrac;
-        _phase  += phaseAcc;
-        _phase  -= 2 * ( _phase > 1 );
+        _phase += _phaseAcc;
+        _phase -= 2 * ( _phase > 1 );
 
-        // calculate the coefficients
+        // smooth the coefficients (always per-sample)
 
         for ( size_t j = 0; j < VOWEL_AMOUNT; ++j )
         {
@@ -135,15 +190,33 @@ void FormantFilter::process( double* inBuffer, int bufferSize )
 
             a->value += ATTENUATOR * ( a->coeffs[ _coeffOffset ] - a->value );
             f->value += ATTENUATOR * ( f->coeffs[ _coeffOffset ] - f->value );
+        }
 
-            // apply formant onto the input signal
+        if ( _synthesisRate == 1 ) {
+            _modulation = synthesize();
+        }
+        else {
+            // synthesize at the synthesis rate and interpolate towards the synthesized value
+            // in between (e.g. the modulation lags behind by a single synthesis interval)
+
+            if ( _synthesisCounter == 0 ) {
+                _modulationStep   = ( synthesize() - _modulation ) / _synthesisRate;
+                _synthesisCounter = _synthesisRate;
+            }
+            --_synthesisCounter;
+            _modulation += _modulationStep;
+        }
+        modulationBuffer[ i ] = _modulation;
+    }
+}
 
-            double formant = APPLY_SYNTHESIS_SIGNAL ? getFormant( _phase, FORMANT_WIDTH_SCALE[ j ] * ufp ) : 1.0;
-            double carrier = getCarrier( f->value * ufp, _phase );
+void FormantFilter::apply( double* inBuffer, double* modulationBuffer, int bufferSize )
+{
+    double out;
 
-            // the fp/fn coefficients stand for a -3dB/oct spectral envelope
-            out += a->value * ( fp / f->value ) * in * formant * carrier;
-        }
+    for ( int i = 0; i < bufferSize; ++i )
+    {
+        out = inBuffer[ i ] * modulationBuffer[ i ];
 
         // catch denormals
 
@@ -155,8 +228,127 @@ void FormantFilter::process( double* inBuffer, int bufferSize )
     }
 }
 
+bool FormantFilter::hasTail()
+{
+    if ( _dEnv > TAIL_THRESHOLD || _dEnv2 > TAIL_THRESHOLD || _dGainEnv > TAIL_THRESHOLD ) {
+        return true;
+    }
+
+    // when the LFO is modulating the vowel, the coefficients continuously
+    // move towards a new target, we don't consider this a tail
+
+    if ( hasLFO ) {
+        return false;
+    }
+
+    for ( size_t j = 0; j < VOWEL_AMOUNT; ++j )
+    {
+        auto a = &A_COEFFICIENTS[ j ];
+        auto f = &F_COEFFICIENTS[ j ];
+
+        if ( std::abs( a->coeffs[ _coeffOffset ] - a->value ) > TAIL_LEVEL_THRESHOLD ||
+             std::abs( f->coeffs[ _coeffOffset ] - f->value ) > TAIL_FREQ_THRESHOLD ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FormantFilter::skip( int bufferSize )
+{
+    lfo.advance( bufferSize );
+}
+
+bool FormantFilter::isEqualTo( FormantFilter* other )
+{
+    if ( _vowel    != other->_vowel    || _tempVowel != other->_tempVowel || _coeffOffset != other->_coeffOffset ||
+         _lfoRange != other->_lfoRange || _lfoMax    != other->_lfoMax    || _lfoMin      != other->_lfoMin ||
+         hasLFO    != other->hasLFO    || _phase     != other->_phase ) {
+        return false;
+    }
+
+    if ( _controlRate != other->_controlRate || _controlCounter != other->_controlCounter || _phaseAcc != other->_phaseAcc ) {
+        return false;
+    }
+
+    if ( _synthesisRate != other->_synthesisRate || _synthesisCounter != other->_synthesisCounter ||
+         _modulation    != other->_modulation    || _modulationStep   != other->_modulationStep ) {
+        return false;
+    }
+
+    if ( _dEnv != other->_dEnv || _dEnv2 != other->_dEnv2 || _dGainEnv != other->_dGainEnv ) {
+        return false;
+    }
+
+    if ( lfo.getRate() != other->lfo.getRate() || lfo.getAccumulator() != other->lfo.getAccumulator()) {
+        return false;
+    }
+
+    for ( size_t j = 0; j < VOWEL_AMOUNT; ++j )
+    {
+        if ( A_COEFFICIENTS[ j ].value != other->A_COEFFICIENTS[ j ].value ||
+             F_COEFFICIENTS[ j ].value != other->F_COEFFICIENTS[ j ].value ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FormantFilter::copyState( FormantFilter* other )
+{
+    _dEnv     = other->_dEnv;
+    _dEnv2    = other->_dEnv2;
+    _dGainEnv = other->_dGainEnv;
+
+    copyModulation( other );
+}
+
+void FormantFilter::copyModulation( FormantFilter* other )
+{
+    _tempVowel   = other->_tempVowel;
+    _coeffOffset = other->_coeffOffset;
+    _phase       = other->_phase;
+
+    _controlCounter = other->_controlCounter;
+    _fp             = other->_fp;
+    _ufp            = other->_ufp;
+    _phaseAcc       = other->_phaseAcc;
+
+    _synthesisCounter = other->_synthesisCounter;
+    _modulation       = other->_modulation;
+    _modulationStep   = other->_modulationStep;
+
+    lfo.setAccumulator( other->lfo.getAccumulator());
+
+    for ( size_t j = 0; j < VOWEL_AMOUNT; ++j )
+    {
+        A_COEFFICIENTS[ j ].value = other->A_COEFFICIENTS[ j ].value;
+        F_COEFFICIENTS[ j ].value = other->F_COEFFICIENTS[ j ].value;
+    }
+}
+
 /* private methods */
 
+double FormantFilter::synthesize()
+{
+    double out = 0.0;
+
+    for ( size_t j = 0; j < VOWEL_AMOUNT; ++j )
+    {
+        auto a = &A_COEFFICIENTS[ j ];
+        auto f = &F_COEFFICIENTS[ j ];
+
+        // calculate the formant to apply onto the input signal
+
+        double formant = APPLY_SYNTHESIS_SIGNAL ? getFormant( _phase, FORMANT_WIDTH_SCALE[ j ] * _ufp ) : 1.0;
+        double carrier = getCarrier( f->value * _ufp, _phase );
+
+        // the fp/fn coefficients stand for a -3dB/oct spectral envelope
+        out += a->value * ( _fp / f->value ) * formant * carrier;
+    }
+    return out;
+}
+
 void FormantFilter::cacheLFO()
 {
     // when LFO is "off" we mock a depth of 0. In reality we keep
@@ -168,6 +360,41 @@ void FormantFilter::cacheLFO()
     _lfoMin   = std::max( 0., _vowel - _lfoRange / 2. );
 }
 
+void FormantFilter::sweep()
+{
+    float lfoValue = lfo.peek() * .5f  + .5f; // make waveform unipolar
+
+    // the LFO moves by the full control rate interval
+
+    if ( _controlRate > 1 ) {
+        lfo.advance( _controlRate - 1 );
+    }
+    _tempVowel = std::min( _lfoMax, _lfoMin + _lfoRange * lfoValue ); // relative to LFO depth
+
+    cacheCoeffOffset(); // ensure the appropriate coeff is used for the new _tempVowel value
+
+    // calculate the phase increment for the formant synthesis and carrier
+
+    _fp  = 12 * powf( 2.0, 4 - 4 * _tempVowel );   // sweep
+    // _fp *= ( 1.0 + 0.01 * sinf( tmp * 0.0015 )); // optional vibrato (sinf value determines speed)
+    _ufp = 1.0 / _fp;
+
+    _phaseAcc = _fp * _halfSampleRateFrac;
+}
+
+bool FormantFilter::generateFormantTable()
+{
+    double coeff = 2.0 / ( FORMANT_TABLE_SIZE - 1 );
+
+    for ( size_t i = 0; i < MAX_FORMANT_WIDTH; i++ )
+    {
+        for ( size_t j = 0; j < FORMANT_TABLE_SIZE; j++ ) {
+            FORMANT_TABLE[ j + i * FORMANT_TABLE_SIZE ] = generateFormant( -1 + j * coeff, double( i ));
+        }
+    }
+    return true;
+}
+
 double FormantFilter::generateFormant( double phase, const double width )
 {
     int hmax    = int( 10 * width ) > FORMANT_TABLE_SIZE / 2 ? FORMANT_TABLE_SIZE / 2 : int( 10 * width );
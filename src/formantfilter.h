@@ -30,14 +30,25 @@
 #include <math.h>
 
 namespace Igorski {
-class FormantFilter
+
+// each instance is aligned to (and padded to a multiple of) the cache line size so
+// filters allocated contiguously (e.g. one per channel) never share a cache line
+
+class alignas( 64 ) FormantFilter
 {
     static const int VOWEL_AMOUNT       = 4;
     static const int COEFF_AMOUNT       = 9;
     static const int FORMANT_TABLE_SIZE = (256+1); // The last entry of the table equals the first (to avoid a modulo)
     static const int MAX_FORMANT_WIDTH  = 64;
+    static constexpr int MODULATION_BLOCK = 64; // size of the sub-blocks in which the modulation is calculated
     static constexpr double ATTENUATOR  = 0.0005;
 
+    // below these deltas the envelopes and coefficient smoothing are considered settled
+
+    static constexpr double TAIL_THRESHOLD       = 1.0e-5;
+    static constexpr double TAIL_FREQ_THRESHOLD  = 1.0;   // in Hz
+    static constexpr double TAIL_LEVEL_THRESHOLD = 0.001;
+
     // hard coded values for dynamics processing, in -1 to +1 range
 
     static constexpr double DYNAMICS_THRESHOLD                  = 0.10;
@@ -60,12 +71,62 @@ class FormantFilter
         FormantFilter( float aVowel, float sampleRate );
         ~FormantFilter();
 
+        void setSampleRate( float sampleRate );
         void setVowel( float aVowel );
         float getVowel();
         void setLFO( float LFORatePercentage, float LFODepth );
+
+        // the interval (in samples) at which the vowel sweep (LFO, active vowel coefficient
+        // and formant frequency) is recalculated. 1 equals per-sample modulation while higher
+        // values trade accuracy for speed. The coefficient smoothing remains per-sample
+
+        void setControlRate( int controlRate );
+
+        // the interval (in samples) at which the formant carriers are synthesized, the modulation
+        // is linearly interpolated in between. 1 equals per-sample synthesis while higher values
+        // trade high frequency accuracy for speed (the synthesis being the costliest stage)
+
+        void setSynthesisRate( int synthesisRate );
         void process( double* inBuffer, int bufferSize );
 
-        LFO* lfo;
+        // the processing is split in two stages: modulate() sweeps the LFO, vowel coefficients
+        // and carrier (which are independent of the input signal) and writes the resulting
+        // per-sample gain into given modulationBuffer. apply() applies the modulation onto the
+        // input signal and runs the dynamics processing. This allows multiple filters sharing the
+        // same settings to calculate the modulation once (see copyModulation())
+
+        void modulate( double* modulationBuffer, int bufferSize );
+        void apply( double* inBuffer, double* modulationBuffer, int bufferSize );
+
+        // whether the dynamics envelopes or coefficient smoothing have yet to settle
+
+        bool hasTail();
+
+        // advance the LFO by given buffer size without processing
+
+        void skip( int bufferSize );
+
+        // whether given filter has the exact same settings and processing state as this
+        // filter, in which case processing equal input results in equal output
+
+        bool isEqualTo( FormantFilter* other );
+
+        // copy the processing state of given filter (which should have equal settings)
+
+        void copyState( FormantFilter* other );
+
+        // copy the modulation state (e.g. excluding dynamics) of given filter (which should have equal settings)
+
+        void copyModulation( FormantFilter* other );
+
+        // the current state of the formants (e.g. for visualisation): the vowel (including the
+        // LFO modulation) and the smoothed frequency (in Hz) and amplitude of each of the VOWEL_AMOUNT
+        // formants. These are only updated while processing and should be read by the audio thread
+
+        float getCurrentVowel();
+        void getFormants( float* frequencies, float* amplitudes );
+
+        LFO lfo;
         bool hasLFO;
 
     private:
@@ -80,7 +141,22 @@ class FormantFilter
         double _lfoMax;
         double _lfoMin;
 
+        int    _controlRate;
+        int    _controlCounter; // samples remaining until the next vowel sweep calculation
+        double _fp;             // current formant frequency
+        double _ufp;            // and its reciprocal
+        double _phaseAcc;       // phase increment per sample
+
+        int    _synthesisRate;
+        int    _synthesisCounter; // samples remaining until the next carrier synthesis
+        double _modulation;       // most recent modulation value
+        double _modulationStep;   // per-sample increment of the interpolated modulation
+
         void cacheLFO();
+        void sweep();
+
+        // sums the carriers of all formants for the current phase and coefficients
+        double synthesize();
         inline void cacheCoeffOffset()
         {
             _coeffOffset = ( int ) Calc::scale( _tempVowel, 1.f, ( float ) COEFF_AMOUNT - 1 );
@@ -110,17 +186,20 @@ class FormantFilter
         };
 
         // the below are used for the formant synthesis
+        // the formant table is equal for all filters (and sample rate agnostic)
+        // and is generated once, upon construction of the first filter
 
-        double FORMANT_TABLE[ FORMANT_TABLE_SIZE * MAX_FORMANT_WIDTH ];
+        static double FORMANT_TABLE[ FORMANT_TABLE_SIZE * MAX_FORMANT_WIDTH ];
         double _phase = 0.0;
 
-        double generateFormant( double phase, const double width );
+        static bool generateFormantTable();
+        static double generateFormant( double phase, const double width );
         double getFormant( double phase, double width );
         double getCarrier( const double position, const double phase );
 
         // Fast approximation of cos( pi * x ) for x in -1 to +1 range
 
-        inline double fast_cos( const double x )
+        static inline double fast_cos( const double x )
         {
             double x2 = x * x;
             return 1 + x2 * ( -4 + 2 * x2 );
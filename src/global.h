@@ -38,6 +38,10 @@ namespace VST {
     static const FUID ProcessorUID( 0x9B87BC9B, 0x0D974BF4, 0x812B59EA, 0xAE2F10A2 );
     static const FUID ControllerUID( 0x73A7B7C0, 0x1AD743C1, 0xBFBFD9F4, 0x5F5A04E1 );
 
+    // maximum amount of channels supported in a single bus (see Transformant::setBusArrangements)
+
+    static const int MAX_CHANNELS = 32;
+
     static const float PI     = 3.141592653589793f;
     static const float TWO_PI = PI * 2.f;
 
@@ -21,6 +21,7 @@
  * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "lfo.h"
+#include <math.h>
 
 namespace Igorski {
 
@@ -28,6 +29,7 @@ LFO::LFO( float sampleRate ) {
     _rate        = VST::MIN_LFO_RATE();
     _accumulator = 0.f;
     _sampleRate  = sampleRate;
+    _interpolate = false;
 }
 
 LFO::~LFO() {
@@ -46,6 +48,22 @@ void LFO::setRate( float value )
     _rate = value;
 }
 
+void LFO::setSampleRate( float sampleRate )
+{
+    _accumulator *= ( sampleRate / _sampleRate );
+    _sampleRate   = sampleRate;
+}
+
+void LFO::advance( int samples )
+{
+    _accumulator = fmodf( _accumulator + _rate * samples, _sampleRate );
+}
+
+void LFO::setInterpolation( bool interpolate )
+{
+    _interpolate = interpolate;
+}
+
 void LFO::setAccumulator( float value )
 {
     _accumulator = value;
@@ -35,12 +35,26 @@ class LFO {
         float getRate();
         void setRate( float value );
 
+        // updates the sample rate, keeping the current position within the wave table
+
+        void setSampleRate( float sampleRate );
+
         // accumulators are used to retrieve a sample from the wave table
         // in other words: track the progress of the oscillator against its range
 
         float getAccumulator();
         void setAccumulator( float offset );
 
+        // moves the accumulator by given amount of samples (as if peek()
+        // was invoked as many times)
+
+        void advance( int samples );
+
+        // whether to linearly interpolate between the wave table entries
+        // (smoother modulation at a slightly higher cost)
+
+        void setInterpolation( bool interpolate );
+
         /**
          * retrieve a value from the wave table for the current
          * accumulator position, this method also increments
@@ -50,7 +64,14 @@ class LFO {
         {
             // the wave table offset to read from
             float SR_OVER_LENGTH = _sampleRate / ( float ) TABLE_SIZE;
-            int readOffset = ( _accumulator == 0.f ) ? 0 : ( int ) ( _accumulator / SR_OVER_LENGTH );
+            float position       = _accumulator / SR_OVER_LENGTH;
+            int readOffset       = ( _accumulator == 0.f ) ? 0 : ( int ) position;
+            float value          = VST::TABLE[ readOffset ];
+
+            if ( _interpolate ) {
+                float next = VST::TABLE[ ( readOffset + 1 ) & ( TABLE_SIZE - 1 ) ];
+                value += ( position - ( float ) readOffset ) * ( next - value );
+            }
 
             // increment the accumulators read offset
             _accumulator += _rate;
@@ -60,7 +81,7 @@ class LFO {
                 _accumulator -= _sampleRate;
 
             // return the sample present at the calculated offset within the table
-            return VST::TABLE[ readOffset ];
+            return value;
         }
 
     private:
@@ -73,6 +94,7 @@ class LFO {
         float _rate;
         float _accumulator;   // is read offset in wave table buffer
         float _sampleRate;
+        bool  _interpolate;
 };
 }
 
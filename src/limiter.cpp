@@ -69,6 +69,36 @@ float Limiter::getLinearGR()
     return gain > 1.f ? 1.f / gain : 1.f;
 }
 
+bool Limiter::hasTail()
+{
+    return fabs( 1.f - gain ) > 0.001f;
+}
+
+float Limiter::getPeak( int channel )
+{
+    return meterPeak[ channel ];
+}
+
+double Limiter::getSumOfSquares( int channel )
+{
+    return meterSquares[ channel ];
+}
+
+float Limiter::getMinimumGain()
+{
+    return meterGain;
+}
+
+void Limiter::resetMeter()
+{
+    for ( int c = 0; c < METER_CHANNELS; ++c ) {
+        meterPeak[ c ]    = 0.f;
+        meterSquares[ c ] = 0.0;
+    }
+    // when no audio is processed until the next reading, the current gain is reported
+    meterGain = gain;
+}
+
 /* protected methods */
 
 void Limiter::init( float attackMs, float releaseMs, float thresholdDb )
@@ -82,6 +112,7 @@ void Limiter::init( float attackMs, float releaseMs, float thresholdDb )
     gain = 1.f;
 
     recalculate();
+    resetMeter();
 }
 
 void Limiter::recalculate()
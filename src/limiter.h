@@ -36,8 +36,12 @@ class Limiter
         Limiter( float attackMs, float releaseMs, float thresholdDb );
         ~Limiter();
 
+        // when provided, the analysis of each channel (see AudioBuffer::analyse()) allows the limiter
+        // to flush non finite samples and to only update its gain envelope when all channels are silent
+
         template <typename SampleType>
-        void process( SampleType** outputBuffer, int bufferSize, int numOutChannels );
+        void process( SampleType** outputBuffer, int bufferSize, int numOutChannels,
+                      const AudioBuffer::Analysis* analysis = nullptr );
 
         void setAttack( float attackMs );
         void setRelease( float releaseMs );
@@ -45,6 +49,20 @@ class Limiter
 
         float getLinearGR();
 
+        // whether the gain reduction has yet to be fully released
+
+        bool hasTail();
+
+        // the output is metered while processing (for the first METER_CHANNELS channels), the
+        // meter values are accumulated across process() invocations until resetMeter() is invoked
+
+        static const int METER_CHANNELS = 2;
+
+        float  getPeak( int channel );         // highest absolute output sample value
+        double getSumOfSquares( int channel ); // sum of the squared output samples (for the RMS)
+        float  getMinimumGain();               // lowest applied gain (e.g. the largest reduction)
+        void   resetMeter();
+
     protected:
         void init( float attackMs, float releaseMs, float thresholdDb );
         void recalculate();
@@ -56,6 +74,10 @@ class Limiter
         float pKnee;
 
         float thresh, gain, att, rel, trim;
+
+        float  meterPeak[ METER_CHANNELS ];
+        double meterSquares[ METER_CHANNELS ];
+        float  meterGain;
 };
 
 #include "limiter.tcc"
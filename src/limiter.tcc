@@ -24,15 +24,30 @@
  * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 template <typename SampleType>
-void Limiter::process( SampleType** outputBuffer, int bufferSize, int numOutChannels )
+void Limiter::process( SampleType** outputBuffer, int bufferSize, int numOutChannels,
+                       const AudioBuffer::Analysis* analysis )
 {
-//    if ( gain > 0.9999f && outputBuffer->isSilent )
-//    {
-//        // don't process if input is silent
-//        return;
-//    }
+    bool isSilent = false;
+
+    if ( analysis != nullptr ) {
+        isSilent = true;
+
+        for ( int c = 0; c < numOutChannels; ++c ) {
+            if ( analysis[ c ].hasNonFinite ) {
+                // flush NaN and infinite samples (sample * 0 is NaN for these), as these
+                // would otherwise corrupt the gain (and thus the output of all channels)
+                SampleType* channelBuffer = outputBuffer[ c ];
+                for ( int i = 0; i < bufferSize; ++i ) {
+                    if ( channelBuffer[ i ] * 0 != 0 ) {
+                        channelBuffer[ i ] = 0;
+                    }
+                }
+            }
+            isSilent = isSilent && analysis[ c ].isSilent();
+        }
+    }
 
-    SampleType g, at, re, tr, th, lev, ol, or_;
+    SampleType g, at, re, tr, th, lev, sum;
 
     th = thresh;
     g = gain;
@@ -40,21 +55,58 @@ void Limiter::process( SampleType** outputBuffer, int bufferSize, int numOutChan
     re = rel;
     tr = trim;
 
-    bool hasRight = ( numOutChannels > 1 );
+    // the output is metered while it is written (for the first channels)
+
+    int meteredChannels = numOutChannels < METER_CHANNELS ? numOutChannels : METER_CHANNELS;
+
+    SampleType peak[ METER_CHANNELS ];
+    double squares [ METER_CHANNELS ];
+    SampleType minimumGain = meterGain;
+
+    for ( int c = 0; c < METER_CHANNELS; ++c ) {
+        peak[ c ]    = meterPeak[ c ];
+        squares[ c ] = meterSquares[ c ];
+    }
 
-    SampleType* leftBuffer  = outputBuffer[ 0 ];
-    SampleType* rightBuffer = hasRight ? outputBuffer[ 1 ] : 0;
+    // the gain is linked across all channels, derived from the sum of all channels
+
+    if ( isSilent )
+    {
+        // silent input remains silent (and leaves the meter levels unchanged)
+        // only the gain has to follow its envelope, as the sum of all channels is 0
+
+        for ( int i = 0; i < bufferSize; ++i ) {
+            if ( pKnee > 0.5 ) {
+                lev = 1;
+
+                if ( g > lev ) {
+                    g = g - at * ( g - lev );
+                }
+                else {
+                    g = g + re * ( lev - g );
+                }
+            }
+            else {
+                g = g + ( SampleType )( re * ( 1.f - g ));
+            }
 
-    if ( pKnee > 0.5 )
+            if ( g < minimumGain ) {
+                minimumGain = g;
+            }
+        }
+    }
+    else if ( pKnee > 0.5 )
     {
         // soft knee
 
         for ( int i = 0; i < bufferSize; ++i ) {
 
-            ol  = leftBuffer[ i ];
-            or_ = hasRight ? rightBuffer[ i ] : 0;
+            sum = 0;
+            for ( int c = 0; c < numOutChannels; ++c ) {
+                sum += outputBuffer[ c ][ i ];
+            }
 
-            lev = ( SampleType ) ( 1.f / ( 1.f + th * fabs( ol + or_ )));
+            lev = ( SampleType ) ( 1.f / ( 1.f + th * fabs( sum )));
 
             if ( g > lev ) {
                 g = g - at * ( g - lev );
@@ -63,20 +115,34 @@ void Limiter::process( SampleType** outputBuffer, int bufferSize, int numOutChan
                 g = g + re * ( lev - g );
             }
 
-            leftBuffer[ i ] = ( ol * tr * g );
+            for ( int c = 0; c < numOutChannels; ++c ) {
+                SampleType sample = ( outputBuffer[ c ][ i ] * tr * g );
+                outputBuffer[ c ][ i ] = sample;
+
+                if ( c < meteredChannels ) {
+                    SampleType level = ( SampleType ) fabs( sample );
+                    if ( level > peak[ c ]) {
+                        peak[ c ] = level;
+                    }
+                    squares[ c ] += ( double ) sample * ( double ) sample;
+                }
+            }
 
-            if ( hasRight )
-                rightBuffer[ i ] = ( or_ * tr * g );
+            if ( g < minimumGain ) {
+                minimumGain = g;
+            }
         }
     }
     else
     {
         for ( int i = 0; i < bufferSize; ++i ) {
 
-            ol  = leftBuffer[ i ];
-            or_ = hasRight ? rightBuffer[ i ] : 0;
+            sum = 0;
+            for ( int c = 0; c < numOutChannels; ++c ) {
+                sum += outputBuffer[ c ][ i ];
+            }
 
-            lev = ( SampleType ) ( 0.5 * g * fabs( ol + or_ ));
+            lev = ( SampleType ) ( 0.5 * g * fabs( sum ));
 
             if ( lev > th ) {
                 g = g - ( at * ( lev - th ));
@@ -86,11 +152,29 @@ void Limiter::process( SampleType** outputBuffer, int bufferSize, int numOutChan
                 g = g + ( SampleType )( re * ( 1.f - g ));
             }
 
-            leftBuffer[ i ] = ( ol * tr * g );
+            for ( int c = 0; c < numOutChannels; ++c ) {
+                SampleType sample = ( outputBuffer[ c ][ i ] * tr * g );
+                outputBuffer[ c ][ i ] = sample;
+
+                if ( c < meteredChannels ) {
+                    SampleType level = ( SampleType ) fabs( sample );
+                    if ( level > peak[ c ]) {
+                        peak[ c ] = level;
+                    }
+                    squares[ c ] += ( double ) sample * ( double ) sample;
+                }
+            }
 
-            if ( hasRight )
-                rightBuffer[ i ] = ( or_ * tr * g );
+            if ( g < minimumGain ) {
+                minimumGain = g;
+            }
         }
     }
     gain = g;
+
+    for ( int c = 0; c < METER_CHANNELS; ++c ) {
+        meterPeak[ c ]    = ( float ) peak[ c ];
+        meterSquares[ c ] = squares[ c ];
+    }
+    meterGain = ( float ) minimumGain;
 }
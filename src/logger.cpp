@@ -0,0 +1,169 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "logger.h"
+#include <chrono>
+#include <time.h>
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+Logger::Logger( const char* filename )
+{
+    _file = fopen( filename, "a" );
+
+    _droppedMessages.store( 0 );
+    _reportedDroppedMessages = 0;
+
+    _running.store( _file != nullptr );
+
+    if ( _file != nullptr ) {
+        _thread = std::thread( &Logger::work, this );
+    }
+}
+
+Logger::~Logger()
+{
+    if ( _thread.joinable()) {
+        _running.store( false, std::memory_order_release );
+        _thread.join();
+    }
+
+    if ( _file != nullptr ) {
+        // write the messages logged after the last write
+        write();
+        fclose( _file );
+    }
+}
+
+/* public methods */
+
+bool Logger::isOpen()
+{
+    return _file != nullptr;
+}
+
+bool Logger::log( const char* message )
+{
+    return push( message, NONE, 0, 0.0 );
+}
+
+bool Logger::log( const char* message, int value )
+{
+    return push( message, INTEGER, value, 0.0 );
+}
+
+bool Logger::log( const char* message, double value )
+{
+    return push( message, DOUBLE, 0, value );
+}
+
+uint64 Logger::getDroppedMessages()
+{
+    return _droppedMessages.load( std::memory_order_relaxed );
+}
+
+/* private methods */
+
+bool Logger::push( const char* message, ValueType type, int intValue, double doubleValue )
+{
+    Record* record = ( _file != nullptr ) ? _records.reserve() : nullptr;
+
+    if ( record == nullptr ) {
+        _droppedMessages.fetch_add( 1, std::memory_order_relaxed );
+        return false;
+    }
+
+    record->time = ( int64 ) std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+    record->type        = type;
+    record->intValue    = intValue;
+    record->doubleValue = doubleValue;
+
+    int i = 0;
+    for ( ; i < MESSAGE_LENGTH - 1 && message[ i ] != '\0'; ++i ) {
+        record->message[ i ] = message[ i ];
+    }
+    record->message[ i ] = '\0';
+
+    // publish the record to the writer thread
+
+    _records.publish();
+
+    return true;
+}
+
+void Logger::work()
+{
+    while ( _running.load( std::memory_order_acquire )) {
+        write();
+        std::this_thread::sleep_for( std::chrono::milliseconds( WRITE_INTERVAL ));
+    }
+}
+
+void Logger::write()
+{
+    bool hasWritten = false;
+    const Record* record;
+
+    while (( record = _records.peek()) != nullptr ) {
+        time_t seconds = ( time_t ) ( record->time / 1000000 );
+        struct tm timeInfo;
+    #ifdef _WIN32
+        gmtime_s( &timeInfo, &seconds );
+    #else
+        gmtime_r( &seconds, &timeInfo );
+    #endif
+        char timestamp[ 20 ];
+        strftime( timestamp, sizeof( timestamp ), "%Y-%m-%d %H:%M:%S", &timeInfo );
+
+        fprintf( _file, "%s.%06d %s", timestamp, ( int ) ( record->time % 1000000 ), record->message );
+
+        if ( record->type == INTEGER ) {
+            fprintf( _file, " %d", record->intValue );
+        } else if ( record->type == DOUBLE ) {
+            fprintf( _file, " %f", record->doubleValue );
+        }
+        fputc( '\n', _file );
+
+        // release the written record to the logging thread
+
+        _records.release();
+        hasWritten = true;
+    }
+
+    uint64 droppedMessages = _droppedMessages.load( std::memory_order_relaxed );
+
+    if ( droppedMessages != _reportedDroppedMessages ) {
+        fprintf( _file, "(%llu messages dropped)\n", ( unsigned long long ) ( droppedMessages - _reportedDroppedMessages ));
+        _reportedDroppedMessages = droppedMessages;
+        hasWritten = true;
+    }
+
+    if ( hasWritten ) {
+        fflush( _file );
+    }
+}
+
+}
@@ -0,0 +1,104 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __LOGGER_H_INCLUDED__
+#define __LOGGER_H_INCLUDED__
+
+#include "global.h"
+#include "spscring.h"
+#include <atomic>
+#include <stdio.h>
+#include <thread>
+
+namespace Igorski {
+
+/**
+ * Logger writes timestamped messages to a file without blocking the thread that
+ * logs them, so it can be used from the audio thread. Messages are copied as fixed
+ * size records into a lock-free ring buffer, a background thread formats these and
+ * writes them to the file in batches.
+ *
+ * The ring buffer has a single producer: only one thread (e.g. the audio thread)
+ * should log to a Logger instance. When the ring buffer is full, messages are dropped
+ * (the amount of dropped messages is written to the file once there is room again).
+ *
+ * The file is opened and the thread is created upon construction, which should not
+ * happen on the audio thread.
+ */
+class Logger
+{
+    public:
+        static const int CAPACITY       = 1024; // in records, must be a power of two
+        static const int MESSAGE_LENGTH = 64;   // in characters (longer messages are truncated)
+        static constexpr int WRITE_INTERVAL = 50; // in milliseconds
+
+        // messages are appended to the file at given path
+
+        Logger( const char* filename );
+        ~Logger();
+
+        // whether the file could be opened
+
+        bool isOpen();
+
+        // append a message (optionally followed by a value) to the log, these are
+        // realtime safe and return false when the message was dropped
+
+        bool log( const char* message );
+        bool log( const char* message, int value );
+        bool log( const char* message, double value );
+
+        // the amount of messages dropped since construction
+
+        uint64 getDroppedMessages();
+
+    private:
+        enum ValueType {
+            NONE = 0,
+            INTEGER,
+            DOUBLE
+        };
+
+        struct Record {
+            int64     time;  // microseconds since the epoch
+            ValueType type;
+            int       intValue;
+            double    doubleValue;
+            char      message[ MESSAGE_LENGTH ];
+        };
+
+        SpscRing<Record, CAPACITY> _records;
+        FILE* _file;
+
+        std::atomic<uint64> _droppedMessages;
+        uint64 _reportedDroppedMessages;
+
+        std::atomic<bool> _running;
+        std::thread _thread;
+
+        bool push( const char* message, ValueType type, int intValue, double doubleValue );
+        void work();
+        void write();
+};
+}
+
+#endif
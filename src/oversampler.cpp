@@ -0,0 +1,103 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "oversampler.h"
+#include <cmath>
+
+namespace Igorski {
+
+const double Oversampler::COEFFICIENTS[ COEFF_AMOUNT ] = {
+    0.040633460924193, 0.150505129022675, 0.300757055991874, 0.460774504961451,
+    0.609524314896188, 0.738503841118857, 0.849223810392066, 0.949742783705000
+};
+
+/* constructor / destructor */
+
+Oversampler::Oversampler()
+{
+    reset();
+}
+
+Oversampler::~Oversampler()
+{
+
+}
+
+/* public methods */
+
+void Oversampler::upsample( double* inBuffer, double* outBuffer, int bufferSize )
+{
+    // each input sample results in two output samples, one from each allpass chain
+
+    for ( int i = 0; i < bufferSize; ++i ) {
+        double sample = inBuffer[ i ];
+
+        outBuffer[ i * 2 ]     = processChain( _upStages, 0, sample );
+        outBuffer[ i * 2 + 1 ] = processChain( _upStages, 1, sample );
+    }
+}
+
+void Oversampler::downsample( double* inBuffer, double* outBuffer, int bufferSize )
+{
+    // the even sample is fed into the first chain while the (previous) odd
+    // sample is fed into the second chain, the output is their average
+
+    for ( int i = 0; i < bufferSize; ++i ) {
+        double even = inBuffer[ i * 2 ];
+        double odd  = inBuffer[ i * 2 + 1 ];
+
+        outBuffer[ i ] = 0.5 * ( processChain( _downStages, 0, even ) + processChain( _downStages, 1, _downPrevious ));
+
+        _downPrevious = odd;
+    }
+}
+
+void Oversampler::reset()
+{
+    for ( int i = 0; i < COEFF_AMOUNT; ++i ) {
+        _upStages[ i ]   = { 0.0, 0.0 };
+        _downStages[ i ] = { 0.0, 0.0 };
+    }
+    _downPrevious = 0.0;
+}
+
+bool Oversampler::hasTail()
+{
+    for ( int i = 0; i < COEFF_AMOUNT; ++i ) {
+        if ( std::abs( _upStages[ i ].x1 )   > TAIL_THRESHOLD || std::abs( _upStages[ i ].y1 )   > TAIL_THRESHOLD ||
+             std::abs( _downStages[ i ].x1 ) > TAIL_THRESHOLD || std::abs( _downStages[ i ].y1 ) > TAIL_THRESHOLD ) {
+            return true;
+        }
+    }
+    return std::abs( _downPrevious ) > TAIL_THRESHOLD;
+}
+
+void Oversampler::copyState( Oversampler* other )
+{
+    for ( int i = 0; i < COEFF_AMOUNT; ++i ) {
+        _upStages[ i ]   = other->_upStages[ i ];
+        _downStages[ i ] = other->_downStages[ i ];
+    }
+    _downPrevious = other->_downPrevious;
+}
+
+}
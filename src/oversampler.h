@@ -0,0 +1,106 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __OVERSAMPLER_H_INCLUDED__
+#define __OVERSAMPLER_H_INCLUDED__
+
+namespace Igorski {
+
+/**
+ * Oversampler performs 2x up- and downsampling using a polyphase IIR
+ * halfband filter (two parallel chains of first order allpass filters)
+ * which provides over 100 dB of image/alias rejection at a low CPU cost.
+ *
+ * The filter is minimum phase, its group delay (a few samples in the passband)
+ * is not reported as latency. Each instance holds the state for a single channel.
+ */
+class Oversampler
+{
+    public:
+        static const int FACTOR = 2;
+
+        Oversampler();
+        ~Oversampler();
+
+        // upsamples bufferSize samples from inBuffer into outBuffer
+        // (which must be able to hold bufferSize * FACTOR samples)
+
+        void upsample( double* inBuffer, double* outBuffer, int bufferSize );
+
+        // downsamples bufferSize * FACTOR samples from inBuffer into
+        // bufferSize samples in outBuffer (in place processing is allowed)
+
+        void downsample( double* inBuffer, double* outBuffer, int bufferSize );
+
+        // clears the filter state (e.g. when oversampling is (re)enabled)
+
+        void reset();
+
+        // whether the filter state has yet to decay (e.g. the filters are still ringing)
+
+        bool hasTail();
+
+        // copy the filter state of given oversampler (e.g. when the other channel
+        // was processed in its place)
+
+        void copyState( Oversampler* other );
+
+    private:
+
+        // coefficients for 8 allpass stages, transition band of 0.04 (relative to the oversampled rate)
+        // even coefficients belong to the first allpass chain, odd coefficients to the second chain
+
+        static const int COEFF_AMOUNT = 8;
+        static const double COEFFICIENTS[ COEFF_AMOUNT ];
+
+        // below this magnitude the filter state is considered decayed
+
+        static constexpr double TAIL_THRESHOLD = 1.0e-5;
+
+        struct Allpass {
+            double x1;
+            double y1;
+        };
+
+        Allpass _upStages[ COEFF_AMOUNT ];
+        Allpass _downStages[ COEFF_AMOUNT ];
+        double  _downPrevious; // the previous odd sample is fed into the second chain when downsampling
+
+        // run given sample through the first order allpass chain starting at given stage offset
+
+        static inline double processChain( Allpass* stages, int offset, double sample )
+        {
+            for ( int i = offset; i < COEFF_AMOUNT; i += 2 ) {
+                Allpass* stage = &stages[ i ];
+                double out = COEFFICIENTS[ i ] * ( sample - stage->y1 ) + stage->x1;
+
+                stage->x1 = sample;
+                stage->y1 = out;
+
+                sample = out;
+            }
+            return sample;
+        }
+};
+}
+
+#endif
@@ -37,7 +37,13 @@ enum
     kDistortionTypeId,     // distortion type
     kDriveId,              // distortion drive amount
     kDistortionChainId,    // distortion pre/pos formant mix
-    kVuPPMId               // for the Vu value return to host
+    kCpuBudgetId,          // share of the realtime block deadline this instance may use (see CpuGovernor)
+    kVuPPMId,              // limiter gain (read only, reported by the processor, 1 is no reduction)
+    kQualityTierId,        // active processing quality tier (read only, reported by the processor)
+    kOutputPeakLId,        // output peak level L (read only, reported by the processor)
+    kOutputPeakRId,        // output peak level R (read only, reported by the processor)
+    kOutputRMSLId,         // output RMS level L (read only, reported by the processor)
+    kOutputRMSRId          // output RMS level R (read only, reported by the processor)
 };
 
 #endif
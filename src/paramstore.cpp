@@ -0,0 +1,88 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "paramstore.h"
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+ParameterStore::ParameterStore()
+{
+    for ( int i = 0; i < PARAM_AMOUNT; ++i ) {
+        _values[ i ].store( 0.f );
+        _snapshot[ i ] = 0.f;
+    }
+    // all parameters are to be applied upon first sync
+    _dirty.store( ALL );
+    _sequence.store( 0 );
+}
+
+ParameterStore::~ParameterStore()
+{
+
+}
+
+/* public methods */
+
+void ParameterStore::beginUpdate()
+{
+    while ( _updateLock.test_and_set( std::memory_order_acquire )) {
+        // other (non realtime) writers only hold the lock for the duration of a few writes
+    }
+    _sequence.fetch_add( 1, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+}
+
+void ParameterStore::endUpdate()
+{
+    _sequence.fetch_add( 1, std::memory_order_release );
+    _updateLock.clear( std::memory_order_release );
+}
+
+uint32 ParameterStore::consume()
+{
+    uint32 sequence = _sequence.load( std::memory_order_acquire );
+
+    if ( sequence & 1 ) {
+        return 0; // update in progress, try again on the next block
+    }
+    uint32 flags = _dirty.exchange( 0, std::memory_order_acquire );
+
+    if ( flags == 0 ) {
+        return 0;
+    }
+
+    for ( int i = 0; i < PARAM_AMOUNT; ++i ) {
+        _snapshot[ i ] = _values[ i ].load( std::memory_order_relaxed );
+    }
+    std::atomic_thread_fence( std::memory_order_acquire );
+
+    if ( _sequence.load( std::memory_order_relaxed ) != sequence ) {
+        // an update started while copying, restore the flags and try again on the next block
+        _dirty.fetch_or( flags, std::memory_order_release );
+        return 0;
+    }
+    return flags;
+}
+
+}
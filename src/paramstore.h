@@ -0,0 +1,132 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __PARAMSTORE_H_INCLUDED__
+#define __PARAMSTORE_H_INCLUDED__
+
+#include "global.h"
+#include "paramids.h"
+#include <atomic>
+
+namespace Igorski {
+
+/**
+ * ParameterStore holds the latest value of all automatable parameters
+ * and keeps track of which parameters have changed since they were
+ * last applied to the processors.
+ *
+ * Values can be written from any thread (e.g. the audio thread while
+ * reading the hosts parameter queues, or the UI thread when restoring
+ * state) while the audio thread consumes the changes at the start of
+ * each block, without locking.
+ *
+ * Writes that belong together (e.g. a restored state) are made between
+ * beginUpdate() and endUpdate(). These bump a sequence number, which the
+ * audio thread uses to copy the values into a snapshot that never mixes
+ * values from before and after such an update. While an update is in
+ * progress the changes are deferred to the next block.
+ */
+class ParameterStore
+{
+    public:
+        // the amount of automatable parameters (kVowelLId through kCpuBudgetId)
+
+        static const int PARAM_AMOUNT = kCpuBudgetId;
+
+        // flag that marks all parameters as dirty
+
+        static const uint32 ALL = (( 1u << PARAM_AMOUNT ) - 1 ) << 1;
+
+        ParameterStore();
+        ~ParameterStore();
+
+        // store a new value for given parameter id. The parameter is
+        // only flagged as dirty when its value has actually changed
+
+        inline void set( int32 paramId, float value )
+        {
+            if ( paramId < 1 || paramId > PARAM_AMOUNT ) {
+                return;
+            }
+            if ( _values[ paramId - 1 ].exchange( value, std::memory_order_relaxed ) != value ) {
+                _dirty.fetch_or( toFlag( paramId ), std::memory_order_release );
+            }
+        }
+
+        // group the writes made in between so they are applied to the processors in
+        // the same block. Should not be invoked by the audio thread, which writes its
+        // changes before consuming them (and thus never tears its own updates)
+
+        void beginUpdate();
+        void endUpdate();
+
+        // the most recently stored value for given parameter id
+
+        inline float get( int32 paramId )
+        {
+            return _values[ paramId - 1 ].load( std::memory_order_relaxed );
+        }
+
+        // flag given parameters as dirty so they are applied on the next consume()
+        // (e.g. to force a full resync after the processors have been reconfigured)
+
+        inline void invalidate( uint32 flags = ALL )
+        {
+            _dirty.fetch_or( flags, std::memory_order_release );
+        }
+
+        // retrieve the flags of all parameters that have changed since the last
+        // invocation, clearing them and taking a snapshot of the current values.
+        // Returns 0 (leaving the flags set) while an update is in progress.
+        // Should only be invoked by the audio thread
+
+        uint32 consume();
+
+        // copies the snapshot value for given parameter into given value reference
+        // in case the parameter is part of given (consumed) flags. Returns whether
+        // the value was updated. Should only be invoked by the audio thread
+
+        inline bool fetch( uint32 flags, int32 paramId, float& value )
+        {
+            if (( flags & toFlag( paramId )) == 0 ) {
+                return false;
+            }
+            value = _snapshot[ paramId - 1 ];
+            return true;
+        }
+
+        static inline uint32 toFlag( int32 paramId )
+        {
+            return 1u << paramId;
+        }
+
+    private:
+        std::atomic<float>  _values[ PARAM_AMOUNT ];
+        std::atomic<uint32> _dirty;
+        std::atomic<uint32> _sequence; // odd while an update is in progress
+        std::atomic_flag    _updateLock = ATOMIC_FLAG_INIT; // serializes updates of multiple writers
+
+        float _snapshot[ PARAM_AMOUNT ];
+};
+}
+
+#endif
@@ -22,31 +22,243 @@
  */
 #include "pluginprocess.h"
 #include "calc.h"
+#include "alignedmemory.h"
 #include <math.h>
+#include <new>
+#include <thread>
 
 namespace Igorski {
 
 PluginProcess::PluginProcess( int amountOfChannels, float sampleRate ) {
     _amountOfChannels = amountOfChannels;
+    _maxBufferSize    = 0;
     _sampleRate       = sampleRate;
 
     bitCrusher     = new BitCrusher( 8, 1.f, .5f );
     waveShaper     = new WaveShaper( 0.f, 1.f );
     limiter        = new Limiter( 10.f, 500.f, .95f );
-    formantFilterL = new FormantFilter( 0.f, _sampleRate );
-    formantFilterR = new FormantFilter( 0.f, _sampleRate );
 
-    // will be lazily created in the process function
-    _mixBuffer = nullptr;
+    _formantFilters      = nullptr;
+    _formantFilterAmount = 0;
+    _quality             = Quality::REALTIME;
+    _oversamplers        = nullptr;
+
+    createFormantFilters( _amountOfChannels );
+
+    _workerPool        = nullptr;
+    _offlineProcessing = false;
+
+    _mixBuffer          = nullptr;
+    _modulationBuffer   = nullptr;
+    _bufferPool         = nullptr;
+    _oversamplingBuffer = nullptr;
+    _outputAnalysis     = nullptr;
+    _analysedChannels   = 0;
+
+    createBuffers( _amountOfChannels );
+
+#ifdef ENABLE_STAGE_PROBES
+    _stageStats.reset();
+#endif
 }
 
 PluginProcess::~PluginProcess() {
     delete _mixBuffer;
+    delete _modulationBuffer;
+    delete _bufferPool;
+    delete[] _outputAnalysis;
     delete bitCrusher;
     delete waveShaper;
     delete limiter;
-    delete formantFilterL;
-    delete formantFilterR;
+
+    destroyFormantFilters();
+
+    delete _workerPool;
+}
+
+bool PluginProcess::hasTail() {
+    bool oversample = Quality::SETTINGS[ _quality ].oversampling > 1;
+
+    for ( int c = 0; c < _formantFilterAmount; ++c ) {
+        if ( _formantFilters[ c ].hasTail() || ( oversample && _oversamplers[ c ].hasTail())) {
+            return true;
+        }
+    }
+    return limiter->hasTail();
+}
+
+void PluginProcess::skip( int bufferSize ) {
+    for ( int c = 0; c < _formantFilterAmount; ++c ) {
+        _formantFilters[ c ].skip( bufferSize );
+
+        // the oversamplers have decayed (see hasTail()), clear their remaining state
+        // so processing resumes from silence once the input is audible again
+        _oversamplers[ c ].reset();
+    }
+}
+
+void PluginProcess::reconfigure( float sampleRate, int maxBufferSize, int amountOfChannels ) {
+    if ( sampleRate != _sampleRate ) {
+        _sampleRate = sampleRate;
+
+        // note the formant table is sample rate agnostic and is not regenerated
+        for ( int c = 0; c < _formantFilterAmount; ++c ) {
+            _formantFilters[ c ].setSampleRate( _sampleRate );
+        }
+    }
+
+    if ( amountOfChannels != _formantFilterAmount ) {
+        createFormantFilters( amountOfChannels );
+    }
+
+    if ( amountOfChannels != _amountOfChannels ) {
+        _amountOfChannels = amountOfChannels;
+        createBuffers( _amountOfChannels );
+    }
+
+    _maxBufferSize = maxBufferSize;
+    updateWorkerPool();
+}
+
+void PluginProcess::setOfflineProcessing( bool offline ) {
+    if ( offline != _offlineProcessing ) {
+        _offlineProcessing = offline;
+        updateWorkerPool();
+    }
+}
+
+void PluginProcess::setQuality( Quality::Tier tier ) {
+    if ( tier == _quality ) {
+        return;
+    }
+    bool wasOversampling = Quality::SETTINGS[ _quality ].oversampling > 1;
+
+    _quality = tier;
+
+    // clear the filter state of the oversamplers as it has gone stale
+
+    if ( !wasOversampling && Quality::SETTINGS[ _quality ].oversampling > 1 ) {
+        for ( int c = 0; c < _formantFilterAmount; ++c ) {
+            _oversamplers[ c ].reset();
+        }
+    }
+    applyQuality();
+}
+
+Quality::Tier PluginProcess::getQuality() {
+    return _quality;
+}
+
+/* private methods */
+
+void PluginProcess::applyQuality() {
+    const Quality::Settings& settings = Quality::SETTINGS[ _quality ];
+
+    for ( int c = 0; c < _formantFilterAmount; ++c ) {
+        _formantFilters[ c ].setControlRate( settings.controlRate );
+        _formantFilters[ c ].setSynthesisRate( settings.synthesisRate );
+        _formantFilters[ c ].lfo.setInterpolation( settings.interpolateLFO );
+    }
+}
+
+void PluginProcess::distort( int c, double* channelBuffer, int bufferSize ) {
+    double* buffer = channelBuffer;
+    int size       = bufferSize;
+
+    bool oversample = _oversamplingBuffer != nullptr;
+
+    if ( oversample ) {
+        buffer = _oversamplingBuffer->getBufferForChannel( c );
+        size   = bufferSize * Oversampler::FACTOR;
+
+        _oversamplers[ c ].upsample( channelBuffer, buffer, bufferSize );
+    }
+
+    if ( distortionTypeCrusher ) {
+        bitCrusher->process( buffer, size );
+    } else {
+        waveShaper->process( buffer, size );
+    }
+
+    if ( oversample ) {
+        _oversamplers[ c ].downsample( buffer, channelBuffer, bufferSize );
+    }
+}
+
+void PluginProcess::createFormantFilters( int amount ) {
+    // all filter states are allocated in a single block (where each filter is cache line aligned)
+    // so iterating over the channels walks memory linearly
+
+    FormantFilter* formantFilters = ( FormantFilter* ) AlignedMemory::allocate( amount * sizeof( FormantFilter ));
+
+    if ( formantFilters == nullptr ) {
+        throw std::bad_alloc();
+    }
+
+    for ( int c = 0; c < amount; ++c ) {
+        if ( _formantFilterAmount == 0 ) {
+            new ( &formantFilters[ c ] ) FormantFilter( 0.f, _sampleRate );
+        } else {
+            // inherit from the existing filter for the same channel, or for the same side (left/right)
+            int source = ( c < _formantFilterAmount ) ? c : c % std::min( 2, _formantFilterAmount );
+            new ( &formantFilters[ c ] ) FormantFilter( _formantFilters[ source ] );
+        }
+    }
+    destroyFormantFilters();
+
+    _formantFilters      = formantFilters;
+    _formantFilterAmount = amount;
+
+    // the oversamplers start with a clean state
+    _oversamplers = new Oversampler[ amount ];
+
+    applyQuality();
+}
+
+void PluginProcess::createBuffers( int amountOfChannels ) {
+    // the buffers are sized to hold a single sub-block (see process()) so these needn't be
+    // created while processing, whatever the size of the blocks provided by the host
+
+    delete _mixBuffer;
+    delete _modulationBuffer;
+    delete _bufferPool;
+    delete[] _outputAnalysis;
+
+    _mixBuffer        = new AudioBuffer( amountOfChannels, SUB_BLOCK_SIZE );
+    _modulationBuffer = new AudioBuffer( 2, SUB_BLOCK_SIZE );
+    _bufferPool       = new BufferPool( BUFFER_POOL_CAPACITY, amountOfChannels, SUB_BLOCK_SIZE * Oversampler::FACTOR );
+    _outputAnalysis   = new AudioBuffer::Analysis[ amountOfChannels ];
+    _analysedChannels = 0;
+}
+
+void PluginProcess::updateWorkerPool() {
+    int amountOfThreads = 0;
+
+    // the calling thread processes channels too, hence we need one thread less than there are channels
+
+    if ( _amountOfChannels > 1 && ( _offlineProcessing || _maxBufferSize >= PARALLEL_BLOCK_SIZE )) {
+        int cores = ( int ) std::thread::hardware_concurrency();
+        amountOfThreads = std::max( 0, std::min( _amountOfChannels, cores ) - 1 );
+    }
+
+    if ( _workerPool != nullptr && _workerPool->getAmountOfThreads() == amountOfThreads ) {
+        return;
+    }
+    delete _workerPool;
+    _workerPool = ( amountOfThreads > 0 ) ? new WorkerPool( amountOfThreads ) : nullptr;
+}
+
+void PluginProcess::destroyFormantFilters() {
+    for ( int c = 0; c < _formantFilterAmount; ++c ) {
+        _formantFilters[ c ].~FormantFilter();
+    }
+    AlignedMemory::free( _formantFilters );
+
+    delete[] _oversamplers;
+
+    _formantFilters      = nullptr;
+    _oversamplers        = nullptr;
+    _formantFilterAmount = 0;
 }
 
 }
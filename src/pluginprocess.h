@@ -25,11 +25,17 @@
 
 #include "global.h"
 #include "audiobuffer.h"
+#include "bufferpool.h"
 #include "bitcrusher.h"
 #include "waveshaper.h"
 #include "formantfilter.h"
 #include "limiter.h"
+#include "oversampler.h"
+#include "quality.h"
 #include "snd.h"
+#include "stageprobe.h"
+#include "workerpool.h"
+#include <string.h>
 #include <vector>
 
 using namespace Steinberg;
@@ -37,45 +43,99 @@ using namespace Steinberg;
 namespace Igorski {
 class PluginProcess {
 
+    // minimum block size for which the channels are processed in parallel (when multiple
+    // channels are available), either in realtime or when rendering offline
+
+    static const int PARALLEL_BLOCK_SIZE         = 2048;
+    static const int OFFLINE_PARALLEL_BLOCK_SIZE = 256;
+
+    // amount of scratch buffers available for checkout during a process cycle
+
+    static const int BUFFER_POOL_CAPACITY = 2;
+
     public:
+        // host blocks are processed in sub-blocks of (at most) this size, so the internal buffers
+        // have a fixed size regardless of the (irregular) block sizes the host provides and are never
+        // reallocated while processing. This is a multiple of the SIMD width so all but the last
+        // sub-block of a host block are processed without a scalar remainder
+
+        static constexpr int SUB_BLOCK_SIZE = 512;
+
         PluginProcess( int amountOfChannels, float sampleRate );
         ~PluginProcess();
 
+        // update the processing properties in place (e.g. when the host changes its setup)
+        // only the state depending on changed properties is updated, this is a no-op
+        // when nothing has changed
+
+        void reconfigure( float sampleRate, int maxBufferSize, int amountOfChannels );
+
+        // when processing offline, the channels can be processed in parallel on
+        // smaller block sizes (see PARALLEL_BLOCK_SIZE)
+
+        void setOfflineProcessing( bool offline );
+
+        // the quality tier determines the control and synthesis rate of the formant modulation,
+        // the oversampling of the distortion stage and the LFO table resolution (see quality.h)
+        // switching tiers does not allocate and is safe to do in between process cycles
+
+        void setQuality( Quality::Tier tier );
+        Quality::Tier getQuality();
+
         // apply effect to incoming sampleBuffer contents
+        // channels exceeding the configured amount (see reconfigure()) are passed through unprocessed
 
         template <typename SampleType>
         void process( SampleType** inBuffer, SampleType** outBuffer, int numInChannels, int numOutChannels,
             int bufferSize, uint32 sampleFramesSize
         );
 
-        // for a speed improvement we don't actually iterate over all channels, but assume
-        // that if the first channel is empty, all are.
+        // whether the output of given channel was silent during the last process() invocation
+        // (false for channels that weren't processed, e.g. channels exceeding the configured amount)
 
-        inline bool isBufferSilent( float** buffer, int numChannels, int bufferSize ) {
-            float* channelBuffer = buffer[ 0 ];
-            for ( int32 i = 0; i < bufferSize; ++i ) {
-                if ( channelBuffer[ i ] != 0.f ) {
-                    return false;
-                }
-            }
-            return true;
-        };
+        inline bool isOutputSilent( int channel ) {
+            return channel < _analysedChannels && _outputAnalysis[ channel ].isSilent();
+        }
 
-        inline bool isBufferSilent( double** buffer, int numChannels, int bufferSize ) {
-            double* channelBuffer = buffer[ 0 ];
-            for ( int32 i = 0; i < bufferSize; ++i ) {
-                if ( channelBuffer[ i ] != 0.0 ) {
-                    return false;
-                }
-            }
-            return true;
-        };
+        // whether the internal state of the processors (dynamics envelopes, coefficient
+        // smoothing and limiter gain) has yet to settle. When the input is silent and
+        // there is no remaining tail, processing can be skipped altogether
+
+        bool hasTail();
+
+        // advances the time dependent state of the processors (e.g. the LFOs) by given
+        // buffer size without processing audio, for use when processing is skipped
+
+        void skip( int bufferSize );
 
         BitCrusher* bitCrusher;
         WaveShaper* waveShaper;
         Limiter* limiter;
-        FormantFilter* formantFilterL;
-        FormantFilter* formantFilterR;
+
+        // each channel is processed by its own formant filter, where the even channels
+        // use the left channel settings and the odd channels use the right channel settings
+
+        inline FormantFilter* getFormantFilter( int channel ) {
+            return &_formantFilters[ channel ];
+        }
+
+        inline int getFormantFilterAmount() {
+            return _formantFilterAmount;
+        }
+
+        // scratch buffers for use during processing (nullptr until reconfigure() has been invoked)
+
+        inline BufferPool* getBufferPool() {
+            return _bufferPool;
+        }
+
+#ifdef ENABLE_STAGE_PROBES
+        // cycles spent in each processing stage, per channel (see stageprobe.h)
+
+        inline Stage::Stats* getStageStats() {
+            return &_stageStats;
+        }
+#endif
 
         // whether effects are applied onto the input delay signal or onto
         // the delayed signal itself (false = on input, true = on delay)
@@ -83,22 +143,114 @@ class PluginProcess {
         bool distortionPostMix     = false;
         bool distortionTypeCrusher = false;
 
+        // whether all formant filters share the same (left channel) settings
+
+        bool vowelSync = false;
+
         inline bool hasLFO() {
-            return formantFilterL->hasLFO || formantFilterR->hasLFO;
+            for ( int c = 0; c < _formantFilterAmount; ++c ) {
+                if ( _formantFilters[ c ].hasLFO ) {
+                    return true;
+                }
+            }
+            return false;
         }
 
     private:
-        AudioBuffer* _mixBuffer;  // buffer used for the sample process mixing
+        AudioBuffer* _mixBuffer;        // buffer used for the sample process mixing
+        AudioBuffer* _modulationBuffer; // buffer used to share the formant modulation between channels
+
+        // analysis of each processed output channel prior to limiting (see process()), as the limiter
+        // only scales its input, this also determines whether the limited output is silent
+
+        AudioBuffer::Analysis* _outputAnalysis;
+        int _analysedChannels;
+
+        // the formant filters are allocated contiguously (one per channel), see createFormantFilters()
+
+        FormantFilter* _formantFilters;
+        int _formantFilterAmount;
+
+        // (re)creates the formant filter pool for given amount of channels, when filters
+        // existed before, the new filters inherit their settings and processing state
+
+        void createFormantFilters( int amount );
+        void destroyFormantFilters();
+
+        Quality::Tier _quality;
+
+        // applies the settings of the current quality tier onto the formant filters
+
+        void applyQuality();
+
+        // one oversampler per channel (used when the quality tier requires oversampling)
+        // the oversampled signal is written into the oversampling buffer, which is checked
+        // out from the buffer pool for the duration of a process cycle (nullptr when not oversampling)
+
+        Oversampler* _oversamplers;
+        BufferPool*  _bufferPool;
+        AudioBuffer* _oversamplingBuffer;
+
+        // applies the active distortion type onto given channel buffer
+        // (at the oversampled rate when the quality tier requires it)
+
+        void distort( int c, double* channelBuffer, int bufferSize );
+
+        // worker threads used to process the channels in parallel (nullptr when not applicable)
+
+        WorkerPool* _workerPool;
+        bool _offlineProcessing;
+
+        // (re)creates the worker pool for the current channel amount, buffer size and processing mode
+
+        void updateWorkerPool();
+
+        // processes a sub-block of given size (at most SUB_BLOCK_SIZE), starting at given
+        // offset within the host block, up until the limiter
+
+        template <typename SampleType>
+        void processSubBlock( SampleType** inBuffer, SampleType** outBuffer, int numChannels,
+            int offset, int bufferSize, bool parallel
+        );
+
+        // properties of the sub-block currently being processed, shared with the worker threads
+
+        template <typename SampleType>
+        struct ChannelJob {
+            PluginProcess* pluginProcess;
+            SampleType** outBuffer;
+            int offset;
+            int bufferSize;
+            int modulationGroups;
+            bool isModulationShared;
+        };
+
+        // processes given channel from the pre mix buffer into given output buffer
+        // (e.g. all processing up until the limiter)
+
+        template <typename SampleType>
+        void processChannel( int c, SampleType* channelOutBuffer, int bufferSize, int modulationGroups, bool isModulationShared );
+
+        template <typename SampleType>
+        static void processChannelTask( void* context, int channel );
+
+#ifdef ENABLE_STAGE_PROBES
+        Stage::Stats _stageStats;
+#endif
 
         int   _amountOfChannels;
+        int   _maxBufferSize;
         float _sampleRate;
 
-        // ensures the pre- and post mix buffers match the appropriate amount of channels
-        // and buffer size. this also clones the contents of given in buffer into the pre-mix buffer
-        // the buffers are pooled so this can be called upon each process cycle without allocation overhead
+        // (re)creates the mix, modulation and oversampling buffers (all sized to SUB_BLOCK_SIZE)
+        // and the output analysis for given amount of channels
+
+        void createBuffers( int amountOfChannels );
+
+        // clones the contents of given in buffers (starting at given offset) into the pre-mix buffer
 
         template <typename SampleType>
-        void prepareMixBuffers( SampleType** inBuffer, int numInChannels, int bufferSize );
+        void prepareMixBuffers( SampleType** inBuffer, int numInChannels, int offset, int bufferSize );
 
 };
 }
@@ -28,80 +28,195 @@ void PluginProcess::process( SampleType** inBuffer, SampleType** outBuffer, int
 
     ScopedNoDenormals noDenormals;
 
-    // prepare the mix buffers and clone the incoming buffer contents into the pre-mix buffer
+    int numChannels = std::min( numInChannels, numOutChannels );
 
-    prepareMixBuffers( inBuffer, numInChannels, bufferSize );
+    // the host should respect the negotiated bus arrangement. If it provides more channels than
+    // configured, the surplus channels are passed through unprocessed as the formant filters and
+    // buffers are only (re)allocated by reconfigure() and never on the audio thread
 
-    for ( int32 c = 0; c < numInChannels; ++c )
+    int numConfiguredChannels = std::min( _formantFilterAmount, _mixBuffer->amountOfChannels );
+
+    for ( int c = numConfiguredChannels; c < numChannels; ++c ) {
+        if ( outBuffer[ c ] != inBuffer[ c ] ) {
+            memcpy( outBuffer[ c ], inBuffer[ c ], bufferSize * sizeof( SampleType ));
+        }
+    }
+    numChannels = std::min( numChannels, numConfiguredChannels );
+
+    // the channels are independent up until the limiter. When rendering offline or when processing large
+    // blocks, the channels are processed in parallel by the worker threads (joining before the limiter)
+    // note this is determined by the size of the host block, the parallel work is divided per sub-block
+
+    int parallelBlockSize = _offlineProcessing ? OFFLINE_PARALLEL_BLOCK_SIZE : PARALLEL_BLOCK_SIZE;
+    bool parallel = _workerPool != nullptr && bufferSize >= parallelBlockSize;
+
+    // process the host block in fixed size sub-blocks (the last sub-block holding the remainder)
+    // as the processing is sample accurate, the output is equal to that of a single block
+
+    for ( int offset = 0; offset < bufferSize; offset += SUB_BLOCK_SIZE ) {
+        int subBlockSize = std::min( SUB_BLOCK_SIZE, bufferSize - offset );
+        processSubBlock<SampleType>( inBuffer, outBuffer, numChannels, offset, subBlockSize, parallel );
+    }
+
+    // limit the output signal as it can get quite hot
+    // the output is analysed in a single pass per channel beforehand, the analysis is
+    // shared by the limiter (see Limiter::process()) and the host (see isOutputSilent())
     {
-        SampleType* channelInBuffer  = inBuffer[ c ];
-        SampleType* channelOutBuffer = outBuffer[ c ];
-        auto channelMixBuffer        = _mixBuffer->getBufferForChannel( c );
+        STAGE_PROBE( _stageStats, LIMITER, 0 );
+
+        for ( int c = 0; c < numChannels; ++c ) {
+            _outputAnalysis[ c ] = AudioBuffer::analyse<SampleType>( outBuffer[ c ], bufferSize );
+        }
+        _analysedChannels = numChannels;
+
+        limiter->process<SampleType>( outBuffer, bufferSize, numChannels, _outputAnalysis );
+    }
+}
 
-        // pre formant filter bit crusher processing
+template <typename SampleType>
+void PluginProcess::processSubBlock( SampleType** inBuffer, SampleType** outBuffer, int numChannels,
+                                     int offset, int bufferSize, bool parallel ) {
+
+    FormantFilter* formantFilterL = getFormantFilter( 0 );
+    FormantFilter* formantFilterR = getFormantFilter( std::min( 1, _formantFilterAmount - 1 ));
+
+    // in case of dual mono input (e.g. bit identical left and right channels) where both formant
+    // filters are in the exact same state, both channels will have the same output. We only process
+    // the left channel and copy the result into the right channel (falling back to processing both
+    // channels as soon as either the input or the filter state diverges)
+
+    bool isDualMono = vowelSync && numChannels == 2 &&
+                      memcmp( inBuffer[ 0 ] + offset, inBuffer[ 1 ] + offset, bufferSize * sizeof( SampleType )) == 0 &&
+                      formantFilterL->isEqualTo( formantFilterR );
+
+    int numProcessedChannels = isDualMono ? 1 : numChannels;
+
+    // clone the incoming buffer contents into the pre-mix buffer
+
+    prepareMixBuffers( inBuffer, numProcessedChannels, offset, bufferSize );
+
+    // channels sharing the same settings (all channels when vowel sync is on, otherwise all even
+    // and all odd channels) share their modulation (LFO, vowel sweep and coefficient smoothing).
+    // The modulation is calculated once per group by its first channel's filter, the other filters
+    // in the group merely apply it and perform their dynamics processing
 
-        if ( !distortionPostMix ) {
-            if ( distortionTypeCrusher ) {
-                bitCrusher->process( channelMixBuffer, bufferSize );
-            } else {
-                waveShaper->process( channelMixBuffer, bufferSize );
+    int modulationGroups    = vowelSync ? 1 : std::min( 2, numProcessedChannels );
+    bool isModulationShared = numProcessedChannels > modulationGroups;
+
+    if ( isModulationShared ) {
+        for ( int g = 0; g < modulationGroups; ++g ) {
+            STAGE_PROBE( _stageStats, MODULATION, g );
+
+            FormantFilter* leader = getFormantFilter( g );
+            leader->modulate( _modulationBuffer->getBufferForChannel( g ), bufferSize );
+
+            for ( int c = g + modulationGroups; c < numProcessedChannels; c += modulationGroups ) {
+                getFormantFilter( c )->copyModulation( leader );
             }
         }
+    }
 
-        // formant filter
+    // check out the scratch space for oversampling for the duration of this sub-block
 
-        if ( c % 2 == 0 ) {
-            formantFilterL->process( channelMixBuffer, bufferSize );
-        } else {
-           formantFilterR->process( channelMixBuffer, bufferSize );
+    if ( Quality::SETTINGS[ _quality ].oversampling > 1 && _bufferPool->getAmountOfChannels() >= numProcessedChannels ) {
+        _oversamplingBuffer = _bufferPool->checkout();
+    }
+
+    if ( parallel && numProcessedChannels > 1 ) {
+        ChannelJob<SampleType> job = { this, outBuffer, offset, bufferSize, modulationGroups, isModulationShared };
+        _workerPool->run( &PluginProcess::processChannelTask<SampleType>, &job, numProcessedChannels );
+    } else {
+        for ( int32 c = 0; c < numProcessedChannels; ++c ) {
+            processChannel<SampleType>( c, outBuffer[ c ] + offset, bufferSize, modulationGroups, isModulationShared );
         }
+    }
 
-        // post formant filter bit crusher processing
+    if ( _oversamplingBuffer != nullptr ) {
+        _bufferPool->release( _oversamplingBuffer );
+        _oversamplingBuffer = nullptr;
+    }
 
-        if ( distortionPostMix ) {
-            if ( distortionTypeCrusher ) {
-                bitCrusher->process( channelMixBuffer, bufferSize );
-            } else {
-                waveShaper->process( channelMixBuffer, bufferSize );
-            }
-        }
+    if ( isDualMono ) {
+        memcpy( outBuffer[ 1 ] + offset, outBuffer[ 0 ] + offset, bufferSize * sizeof( SampleType ));
+        // keep the right filter (and oversampler) in the state it would have had if it had processed the input
+        formantFilterR->copyState( formantFilterL );
+        _oversamplers[ 1 ].copyState( &_oversamplers[ 0 ] );
+    }
+}
 
-        // write the effected mix buffers into the output buffer
-        // note here we convert the double values to whatever SampleType is
+template <typename SampleType>
+void PluginProcess::processChannel( int c, SampleType* channelOutBuffer, int bufferSize, int modulationGroups, bool isModulationShared )
+{
+    auto channelMixBuffer = _mixBuffer->getBufferForChannel( c );
 
-        for ( size_t i = 0; i < bufferSize; ++i ) {
+    // pre formant filter bit crusher processing
 
-            // before writing to the out buffer we take a snapshot of the current in sample
-            // value as VST2 in Ableton Live supplies the same buffer for in and out!
-            // in case we want to offer a wet/dry balance
-            //inSample = channelInBuffer[ i ];
+    if ( !distortionPostMix ) {
+        STAGE_PROBE( _stageStats, PRE_DISTORTION, c );
+        distort( c, channelMixBuffer, bufferSize );
+    }
+
+    // formant filter
+
+    FormantFilter* formantFilter = getFormantFilter( c );
+    {
+        STAGE_PROBE( _stageStats, FORMANT, c );
 
-            // wet mix (e.g. the effected signal)
-            channelOutBuffer[ i ] = ( SampleType ) channelMixBuffer[ i ];
+        if ( isModulationShared ) {
+            formantFilter->apply( channelMixBuffer, _modulationBuffer->getBufferForChannel( c % modulationGroups ), bufferSize );
+        } else {
+            formantFilter->process( channelMixBuffer, bufferSize );
         }
     }
-    // limit the output signal as it can get quite hot
-    limiter->process<SampleType>( outBuffer, bufferSize, numOutChannels );
+
+    // post formant filter bit crusher processing
+
+    if ( distortionPostMix ) {
+        STAGE_PROBE( _stageStats, POST_DISTORTION, c );
+        distort( c, channelMixBuffer, bufferSize );
+    }
+
+    // write the effected mix buffers into the output buffer
+    // note here we convert the double values to whatever SampleType is
+
+    STAGE_PROBE( _stageStats, CONVERSION, c );
+
+    for ( int i = 0; i < bufferSize; ++i ) {
+
+        // before writing to the out buffer we take a snapshot of the current in sample
+        // value as VST2 in Ableton Live supplies the same buffer for in and out!
+        // in case we want to offer a wet/dry balance
+        //inSample = channelInBuffer[ i ];
+
+        // wet mix (e.g. the effected signal)
+        channelOutBuffer[ i ] = ( SampleType ) channelMixBuffer[ i ];
+    }
 }
 
 template <typename SampleType>
-void PluginProcess::prepareMixBuffers( SampleType** inBuffer, int numInChannels, int bufferSize )
+void PluginProcess::processChannelTask( void* context, int channel )
 {
-    // if the pre mix buffer wasn't created yet or the buffer size has changed
-    // delete existing buffer and create new one to match properties
+    // note the denormal flags are thread specific and must be set on the worker thread too
+    ScopedNoDenormals noDenormals;
 
-    if ( _mixBuffer == nullptr || _mixBuffer->bufferSize != bufferSize ) {
-        delete _mixBuffer;
-        _mixBuffer = new AudioBuffer( numInChannels, bufferSize );
-    }
+    auto job = ( ChannelJob<SampleType>* ) context;
+    PluginProcess* pluginProcess = job->pluginProcess;
 
+    pluginProcess->processChannel<SampleType>(
+        channel, job->outBuffer[ channel ] + job->offset, job->bufferSize, job->modulationGroups, job->isModulationShared
+    );
+}
+
+template <typename SampleType>
+void PluginProcess::prepareMixBuffers( SampleType** inBuffer, int numInChannels, int offset, int bufferSize )
+{
     // clone the in buffer contents
     // note the clone is always cast to double as it is
     // used for internal processing (see PluginProcess::process)
 
     for ( int c = 0; c < numInChannels; ++c ) {
 
-        SampleType* inChannelBuffer = ( SampleType* ) inBuffer[ c ];
+        SampleType* inChannelBuffer = ( SampleType* ) inBuffer[ c ] + offset;
         auto channelMixBuffer       = ( double* ) _mixBuffer->getBufferForChannel( c );
 
         for ( int i = 0; i < bufferSize; ++i ) {
@@ -0,0 +1,112 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "processstats.h"
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+ProcessStats::ProcessStats()
+{
+    _resetRequested.store( false );
+    clear();
+}
+
+ProcessStats::~ProcessStats()
+{
+
+}
+
+/* public methods */
+
+void ProcessStats::record( uint64 processingTime, int numSamples, uint64 deadline )
+{
+    if ( _resetRequested.exchange( false, std::memory_order_acquire )) {
+        clear();
+    }
+
+    if ( numSamples <= 0 ) {
+        return;
+    }
+
+    // determine the logarithmic bucket for the processing time per sample
+
+    uint64 timePerSample = processingTime / ( uint64 ) numSamples;
+    int bucket = 0;
+
+    while ( timePerSample > 1 && bucket < BUCKET_AMOUNT - 1 ) {
+        timePerSample >>= 1;
+        ++bucket;
+    }
+    increment( _histogram[ bucket ]);
+    increment( _blocks );
+
+    if ( processingTime > _worstBlockTime.load( std::memory_order_relaxed )) {
+        _worstBlockTime.store( processingTime, std::memory_order_relaxed );
+    }
+
+    if ( deadline == 0 ) {
+        return;
+    }
+
+    float load = ( float ) (( double ) processingTime / ( double ) deadline );
+
+    if ( load > _worstLoad.load( std::memory_order_relaxed )) {
+        _worstLoad.store( load, std::memory_order_relaxed );
+    }
+
+    if ( processingTime > deadline ) {
+        increment( _overruns );
+    }
+}
+
+void ProcessStats::reset()
+{
+    _resetRequested.store( true, std::memory_order_release );
+}
+
+void ProcessStats::getSnapshot( Snapshot& snapshot )
+{
+    for ( int i = 0; i < BUCKET_AMOUNT; ++i ) {
+        snapshot.histogram[ i ] = _histogram[ i ].load( std::memory_order_relaxed );
+    }
+    snapshot.blocks         = _blocks.load( std::memory_order_relaxed );
+    snapshot.overruns       = _overruns.load( std::memory_order_relaxed );
+    snapshot.worstBlockTime = _worstBlockTime.load( std::memory_order_relaxed );
+    snapshot.worstLoad      = _worstLoad.load( std::memory_order_relaxed );
+}
+
+/* private methods */
+
+void ProcessStats::clear()
+{
+    for ( int i = 0; i < BUCKET_AMOUNT; ++i ) {
+        _histogram[ i ].store( 0, std::memory_order_relaxed );
+    }
+    _blocks.store( 0, std::memory_order_relaxed );
+    _overruns.store( 0, std::memory_order_relaxed );
+    _worstBlockTime.store( 0, std::memory_order_relaxed );
+    _worstLoad.store( 0.f, std::memory_order_relaxed );
+}
+
+}
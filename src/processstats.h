@@ -0,0 +1,91 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __PROCESSSTATS_H_INCLUDED__
+#define __PROCESSSTATS_H_INCLUDED__
+
+#include "global.h"
+#include <atomic>
+
+namespace Igorski {
+
+/**
+ * ProcessStats keeps track of the time spent processing each block: a histogram
+ * of the processing time per sample (in logarithmic buckets), the amount of blocks
+ * that exceeded their realtime deadline and the worst case since the last reset.
+ *
+ * Blocks are recorded by the audio thread without locking, while the statistics
+ * can be read (and reset) from any thread.
+ */
+class ProcessStats
+{
+    public:
+        // bucket n holds the blocks that took [2^n, 2^(n+1)) nanoseconds per sample to process
+        // (the last bucket also holds all slower blocks)
+
+        static const int BUCKET_AMOUNT = 24;
+
+        struct Snapshot {
+            uint32 histogram[ BUCKET_AMOUNT ];
+            uint32 blocks;
+            uint32 overruns;         // amount of blocks that exceeded their deadline
+            uint64 worstBlockTime;   // longest processing time of a single block, in nanoseconds
+            float  worstLoad;        // highest ratio of processing time to deadline
+        };
+
+        ProcessStats();
+        ~ProcessStats();
+
+        // registers the processing time (in nanoseconds) of a block of given size, given deadline
+        // is the duration of the block in nanoseconds (0 when there is no deadline, e.g. offline)
+        // should only be invoked by the audio thread
+
+        void record( uint64 processingTime, int numSamples, uint64 deadline );
+
+        // clears the statistics, this is applied by the audio thread upon the next record()
+
+        void reset();
+
+        // copies the current statistics into given snapshot
+
+        void getSnapshot( Snapshot& snapshot );
+
+    private:
+        std::atomic<uint32> _histogram[ BUCKET_AMOUNT ];
+        std::atomic<uint32> _blocks;
+        std::atomic<uint32> _overruns;
+        std::atomic<uint64> _worstBlockTime;
+        std::atomic<float>  _worstLoad;
+        std::atomic<bool>   _resetRequested;
+
+        void clear();
+
+        // as there is a single writer, counters can be incremented without read-modify-write operations
+
+        static inline void increment( std::atomic<uint32>& counter )
+        {
+            counter.store( counter.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+        }
+};
+}
+
+#endif
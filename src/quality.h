@@ -0,0 +1,67 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __QUALITY_H_INCLUDED__
+#define __QUALITY_H_INCLUDED__
+
+/**
+ * processing quality tiers. The realtime tier is used for monitoring while the offline
+ * tier (used when the host renders/bounces) favours quality over CPU usage. The low
+ * tier trades modulation accuracy for speed (e.g. when the CPU budget is exceeded), by
+ * synthesizing the formant carriers at a reduced rate it costs about a third of the realtime tier
+ */
+namespace Igorski {
+namespace Quality {
+
+    // ordered from cheapest to most expensive
+
+    enum Tier {
+        LOW = 0,
+        REALTIME,
+        OFFLINE
+    };
+
+    static const int TIER_AMOUNT = 3;
+
+    struct Settings {
+        int  controlRate;        // interval (in samples) at which the vowel sweep is calculated
+        int  synthesisRate;      // interval (in samples) at which the formant carriers are synthesized
+        int  oversampling;       // oversampling factor of the distortion stage (1 or 2)
+        bool interpolateLFO;     // whether the LFO wave table is read using linear interpolation
+    };
+
+    static const Settings SETTINGS[ TIER_AMOUNT ] = {
+        { 16, 4, 1, false }, // LOW
+        {  1, 1, 1, false }, // REALTIME
+        {  1, 1, 2, true  }  // OFFLINE
+    };
+
+    // the tier as a normalized parameter value (e.g. for reporting to the controller)
+
+    static inline double toNormalized( Tier tier )
+    {
+        return ( double ) tier / ( double ) ( TIER_AMOUNT - 1 );
+    }
+}
+}
+
+#endif
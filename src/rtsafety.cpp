@@ -0,0 +1,368 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "rtsafety.h"
+
+#ifdef ENABLE_RT_SAFETY_CHECKS
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined( __linux__ ) && defined( __GLIBC__ )
+#define RT_SAFETY_INTERCEPT_LIBC
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdarg.h>
+#endif
+
+#if defined( __APPLE__ ) || defined( __GLIBC__ )
+#define RT_SAFETY_BACKTRACE
+#include <execinfo.h>
+#endif
+
+// the thread state is accessed from within the allocator, the initial exec model
+// ensures this access does not allocate (as lazily allocated thread storage would)
+
+#if defined( __GNUC__ ) && !defined( _WIN32 )
+#define RT_SAFETY_TLS __attribute__(( tls_model( "initial-exec" )))
+#else
+#define RT_SAFETY_TLS
+#endif
+
+#ifdef RT_SAFETY_INTERCEPT_LIBC
+extern "C" {
+    void* __libc_malloc( size_t size );
+    void* __libc_calloc( size_t amount, size_t size );
+    void* __libc_realloc( void* memory, size_t size );
+    void* __libc_memalign( size_t alignment, size_t size );
+    void  __libc_free( void* memory );
+}
+#endif
+
+namespace Igorski {
+namespace RTSafety {
+
+    static const int MAX_STACK_FRAMES = 32;
+
+    // the amount of (nested) scopes the current thread is in and whether the current thread
+    // is reporting a violation (the calls made while reporting are not checked)
+
+    static thread_local int  _depth RT_SAFETY_TLS     = 0;
+    static thread_local bool _reporting RT_SAFETY_TLS = false;
+
+    static std::atomic<uint64> _violations( 0 );
+    static bool _abortOnViolation = false;
+
+    struct Initializer {
+        Initializer()
+        {
+            const char* mode  = getenv( "TRANSFORMANT_RT_SAFETY" );
+            _abortOnViolation = mode != nullptr && strcmp( mode, "abort" ) == 0;
+
+        #ifdef RT_SAFETY_BACKTRACE
+            // the first backtrace() loads the unwinder (which allocates), do this up front
+            void* frames[ 1 ];
+            backtrace( frames, 1 );
+        #endif
+        }
+    };
+    static Initializer initializer;
+
+    Scope::Scope( bool enabled ) : _enabled( enabled )
+    {
+        if ( _enabled ) {
+            ++_depth;
+        }
+    }
+
+    Scope::~Scope()
+    {
+        if ( _enabled ) {
+            --_depth;
+        }
+    }
+
+    void report( const char* call )
+    {
+        if ( _depth == 0 || _reporting ) {
+            return;
+        }
+        _reporting = true;
+        _violations.fetch_add( 1, std::memory_order_relaxed );
+
+        fprintf( stderr, "RT safety violation: %s called while processing audio\n", call );
+
+    #ifdef RT_SAFETY_BACKTRACE
+        void* frames[ MAX_STACK_FRAMES ];
+        int amountOfFrames = backtrace( frames, MAX_STACK_FRAMES );
+
+        // omit this function from the stack
+        backtrace_symbols_fd( frames + 1, amountOfFrames - 1, fileno( stderr ));
+    #endif
+
+        if ( _abortOnViolation ) {
+            abort();
+        }
+        _reporting = false;
+    }
+
+    uint64 getViolations()
+    {
+        return _violations.load( std::memory_order_relaxed );
+    }
+
+    // the allocators used by the new and delete operators (bypassing the intercepted
+    // malloc() and free() so an allocation is only reported once)
+
+    static void* allocate( size_t size )
+    {
+    #ifdef RT_SAFETY_INTERCEPT_LIBC
+        return __libc_malloc( size );
+    #else
+        return malloc( size );
+    #endif
+    }
+
+    static void* allocateAligned( size_t size, size_t alignment )
+    {
+    #if defined( RT_SAFETY_INTERCEPT_LIBC )
+        return __libc_memalign( alignment, size );
+    #elif defined( _WIN32 )
+        return _aligned_malloc( size, alignment );
+    #else
+        void* memory = nullptr;
+        return posix_memalign( &memory, std::max( alignment, sizeof( void* )), size ) == 0 ? memory : nullptr;
+    #endif
+    }
+
+    static void deallocate( void* memory )
+    {
+    #ifdef RT_SAFETY_INTERCEPT_LIBC
+        __libc_free( memory );
+    #else
+        free( memory );
+    #endif
+    }
+
+    static void deallocateAligned( void* memory )
+    {
+    #ifdef _WIN32
+        _aligned_free( memory );
+    #else
+        deallocate( memory );
+    #endif
+    }
+
+    static void* newOperator( size_t size, const char* call )
+    {
+        report( call );
+        void* memory = allocate( size == 0 ? 1 : size );
+        if ( memory == nullptr ) {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    static void* newAlignedOperator( size_t size, std::align_val_t alignment, const char* call )
+    {
+        report( call );
+        void* memory = allocateAligned( size == 0 ? 1 : size, static_cast<size_t>( alignment ));
+        if ( memory == nullptr ) {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    static void deleteOperator( void* memory, const char* call )
+    {
+        if ( memory != nullptr ) {
+            report( call );
+            deallocate( memory );
+        }
+    }
+
+    static void deleteAlignedOperator( void* memory, const char* call )
+    {
+        if ( memory != nullptr ) {
+            report( call );
+            deallocateAligned( memory );
+        }
+    }
+}
+}
+
+using namespace Igorski::RTSafety;
+
+/* global new and delete operators */
+
+void* operator new( size_t size ) { return newOperator( size, "operator new" ); }
+void* operator new[]( size_t size ) { return newOperator( size, "operator new[]" ); }
+void* operator new( size_t size, std::align_val_t alignment ) { return newAlignedOperator( size, alignment, "operator new" ); }
+void* operator new[]( size_t size, std::align_val_t alignment ) { return newAlignedOperator( size, alignment, "operator new[]" ); }
+
+void* operator new( size_t size, const std::nothrow_t& ) noexcept
+{
+    report( "operator new" );
+    return allocate( size == 0 ? 1 : size );
+}
+
+void* operator new[]( size_t size, const std::nothrow_t& ) noexcept
+{
+    report( "operator new[]" );
+    return allocate( size == 0 ? 1 : size );
+}
+
+void operator delete( void* memory ) noexcept { deleteOperator( memory, "operator delete" ); }
+void operator delete[]( void* memory ) noexcept { deleteOperator( memory, "operator delete[]" ); }
+void operator delete( void* memory, size_t ) noexcept { deleteOperator( memory, "operator delete" ); }
+void operator delete[]( void* memory, size_t ) noexcept { deleteOperator( memory, "operator delete[]" ); }
+void operator delete( void* memory, const std::nothrow_t& ) noexcept { deleteOperator( memory, "operator delete" ); }
+void operator delete[]( void* memory, const std::nothrow_t& ) noexcept { deleteOperator( memory, "operator delete[]" ); }
+void operator delete( void* memory, std::align_val_t ) noexcept { deleteAlignedOperator( memory, "operator delete" ); }
+void operator delete[]( void* memory, std::align_val_t ) noexcept { deleteAlignedOperator( memory, "operator delete[]" ); }
+void operator delete( void* memory, size_t, std::align_val_t ) noexcept { deleteAlignedOperator( memory, "operator delete" ); }
+void operator delete[]( void* memory, size_t, std::align_val_t ) noexcept { deleteAlignedOperator( memory, "operator delete[]" ); }
+
+#ifdef RT_SAFETY_INTERCEPT_LIBC
+
+/* intercepted C library functions */
+
+// returns the next definition of given function (e.g. the one provided by the C library)
+
+template <typename Function>
+static Function getNext( std::atomic<Function>& function, const char* name )
+{
+    Function next = function.load( std::memory_order_relaxed );
+    if ( next == nullptr ) {
+        next = ( Function ) dlsym( RTLD_NEXT, name );
+        function.store( next, std::memory_order_relaxed );
+    }
+    return next;
+}
+
+typedef int   ( *MutexLockFunction )( pthread_mutex_t* );
+typedef FILE* ( *FileOpenFunction )( const char*, const char* );
+typedef int   ( *OpenFunction )( const char*, int, ... );
+
+static std::atomic<MutexLockFunction> nextMutexLock( nullptr );
+static std::atomic<FileOpenFunction>  nextFileOpen( nullptr );
+static std::atomic<FileOpenFunction>  nextFileOpen64( nullptr );
+static std::atomic<OpenFunction>      nextOpen( nullptr );
+static std::atomic<OpenFunction>      nextOpen64( nullptr );
+
+// the mode argument of open() is only provided when creating a file
+
+static mode_t getOpenMode( int flags, va_list arguments )
+{
+    return ( flags & ( O_CREAT | O_TMPFILE )) ? ( mode_t ) va_arg( arguments, int ) : 0;
+}
+
+extern "C" {
+
+void* malloc( size_t size )
+{
+    report( "malloc" );
+    return __libc_malloc( size );
+}
+
+void* calloc( size_t amount, size_t size )
+{
+    report( "calloc" );
+    return __libc_calloc( amount, size );
+}
+
+void* realloc( void* memory, size_t size )
+{
+    report( "realloc" );
+    return __libc_realloc( memory, size );
+}
+
+int posix_memalign( void** memory, size_t alignment, size_t size )
+{
+    report( "posix_memalign" );
+
+    if ( alignment % sizeof( void* ) != 0 || ( alignment & ( alignment - 1 )) != 0 ) {
+        return EINVAL;
+    }
+    *memory = __libc_memalign( alignment, size );
+    return *memory != nullptr ? 0 : ENOMEM;
+}
+
+void free( void* memory )
+{
+    if ( memory != nullptr ) {
+        report( "free" );
+    }
+    __libc_free( memory );
+}
+
+int pthread_mutex_lock( pthread_mutex_t* mutex )
+{
+    report( "pthread_mutex_lock" );
+    return getNext( nextMutexLock, "pthread_mutex_lock" )( mutex );
+}
+
+FILE* fopen( const char* path, const char* mode )
+{
+    report( "fopen" );
+    return getNext( nextFileOpen, "fopen" )( path, mode );
+}
+
+FILE* fopen64( const char* path, const char* mode )
+{
+    report( "fopen" );
+    return getNext( nextFileOpen64, "fopen64" )( path, mode );
+}
+
+int open( const char* path, int flags, ... )
+{
+    va_list arguments;
+    va_start( arguments, flags );
+    mode_t mode = getOpenMode( flags, arguments );
+    va_end( arguments );
+
+    report( "open" );
+    return getNext( nextOpen, "open" )( path, flags, mode );
+}
+
+int open64( const char* path, int flags, ... )
+{
+    va_list arguments;
+    va_start( arguments, flags );
+    mode_t mode = getOpenMode( flags, arguments );
+    va_end( arguments );
+
+    report( "open" );
+    return getNext( nextOpen64, "open64" )( path, flags, mode );
+}
+
+}
+
+#endif
+
+#endif
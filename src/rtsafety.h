@@ -0,0 +1,79 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __RTSAFETY_H_INCLUDED__
+#define __RTSAFETY_H_INCLUDED__
+
+/**
+ * Realtime safety checks for the audio path. When ENABLE_RT_SAFETY_CHECKS is defined
+ * (see CMakeLists.txt) heap allocations, mutex locks and file I/O made by a thread
+ * inside an RT_SAFETY_SCOPE() (e.g. Transformant::process) are reported as a violation,
+ * printing the offending call and its call stack to stderr. When the TRANSFORMANT_RT_SAFETY
+ * environment variable is set to "abort" the process aborts upon the first violation, so
+ * tests fail. Otherwise RT_SAFETY_SCOPE() expands to nothing.
+ *
+ * Allocations are intercepted by replacing the global new and delete operators. On Linux
+ * (glibc) malloc(), free(), pthread_mutex_lock() and opening files are intercepted as well.
+ * Within an executable (e.g. the benchmark tools) this applies to all calls made by the
+ * process, within the plugin library only to the calls made by the plugins own code.
+ */
+#ifdef ENABLE_RT_SAFETY_CHECKS
+
+#include "global.h"
+
+namespace Igorski {
+namespace RTSafety {
+
+    // marks the current thread as processing audio for the lifetime of the scope
+
+    class Scope
+    {
+        public:
+            Scope( bool enabled );
+            ~Scope();
+
+        private:
+            bool _enabled;
+    };
+
+    // reports a violation when given call is made by a thread inside a scope
+
+    void report( const char* call );
+
+    // the amount of violations reported since the process started
+
+    uint64 getViolations();
+}
+}
+
+#define RT_SAFETY_CONCAT_( a, b ) a##b
+#define RT_SAFETY_CONCAT( a, b ) RT_SAFETY_CONCAT_( a, b )
+#define RT_SAFETY_SCOPE( enabled ) \
+    Igorski::RTSafety::Scope RT_SAFETY_CONCAT( rtSafetyScope, __LINE__ )( enabled )
+
+#else
+
+#define RT_SAFETY_SCOPE( enabled )
+
+#endif
+
+#endif
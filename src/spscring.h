@@ -0,0 +1,77 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __SPSCRING_H_INCLUDED__
+#define __SPSCRING_H_INCLUDED__
+
+#include "global.h"
+#include <atomic>
+
+namespace Igorski {
+
+/**
+ * SpscRing is a lock-free ring buffer holding up to CAPACITY elements, for handing
+ * data from a single producer thread to a single consumer thread (e.g. from the audio
+ * thread to a background or UI thread) without either thread waiting on the other.
+ *
+ * Elements are written and read in place: the producer reserves the next free element
+ * and publishes it once written, the consumer peeks at the oldest published element and
+ * releases it once read. The elements are allocated upon construction.
+ */
+template <typename T, int CAPACITY>
+class SpscRing
+{
+    static_assert( CAPACITY > 0 && ( CAPACITY & ( CAPACITY - 1 )) == 0, "CAPACITY must be a power of two" );
+
+    public:
+        SpscRing();
+        ~SpscRing();
+
+        // the element to write into, or nullptr when the ring is full
+        // should only be invoked by the producer, followed by publish() once written
+
+        T* reserve();
+        void publish();
+
+        // the oldest unread element, or nullptr when the ring is empty
+        // should only be invoked by the consumer, followed by release() once read
+
+        T* peek();
+        void release();
+
+        // discards all unread elements, should only be invoked by the consumer
+
+        void clear();
+
+    private:
+        T* _elements;
+
+        // the indices are written by different threads, keep them on separate cache lines
+
+        alignas( 64 ) std::atomic<uint32> _writeIndex;
+        alignas( 64 ) std::atomic<uint32> _readIndex;
+};
+}
+
+#include "spscring.tcc"
+
+#endif
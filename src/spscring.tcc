@@ -0,0 +1,80 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+namespace Igorski
+{
+template <typename T, int CAPACITY>
+SpscRing<T, CAPACITY>::SpscRing()
+{
+    _elements = new T[ CAPACITY ];
+
+    _writeIndex.store( 0 );
+    _readIndex.store( 0 );
+}
+
+template <typename T, int CAPACITY>
+SpscRing<T, CAPACITY>::~SpscRing()
+{
+    delete[] _elements;
+}
+
+template <typename T, int CAPACITY>
+T* SpscRing<T, CAPACITY>::reserve()
+{
+    uint32 writeIndex = _writeIndex.load( std::memory_order_relaxed );
+
+    if ( writeIndex - _readIndex.load( std::memory_order_acquire ) >= ( uint32 ) CAPACITY ) {
+        return nullptr;
+    }
+    return &_elements[ writeIndex & ( CAPACITY - 1 )];
+}
+
+template <typename T, int CAPACITY>
+void SpscRing<T, CAPACITY>::publish()
+{
+    _writeIndex.store( _writeIndex.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+}
+
+template <typename T, int CAPACITY>
+T* SpscRing<T, CAPACITY>::peek()
+{
+    uint32 readIndex = _readIndex.load( std::memory_order_relaxed );
+
+    if ( readIndex == _writeIndex.load( std::memory_order_acquire )) {
+        return nullptr;
+    }
+    return &_elements[ readIndex & ( CAPACITY - 1 )];
+}
+
+template <typename T, int CAPACITY>
+void SpscRing<T, CAPACITY>::release()
+{
+    _readIndex.store( _readIndex.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+}
+
+template <typename T, int CAPACITY>
+void SpscRing<T, CAPACITY>::clear()
+{
+    _readIndex.store( _writeIndex.load( std::memory_order_acquire ), std::memory_order_release );
+}
+
+}
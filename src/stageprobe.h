@@ -0,0 +1,131 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __STAGEPROBE_H_INCLUDED__
+#define __STAGEPROBE_H_INCLUDED__
+
+/**
+ * Scoped probes measuring the amount of cycles spent in each stage of the
+ * processing chain, per channel. Probes are only compiled when ENABLE_STAGE_PROBES
+ * is defined (see CMakeLists.txt), otherwise STAGE_PROBE() expands to nothing.
+ *
+ * On x86 the time stamp counter is read, other architectures measure nanoseconds.
+ */
+#ifdef ENABLE_STAGE_PROBES
+
+#include "global.h"
+#include <chrono>
+
+#if defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ))
+#include <intrin.h>
+#define STAGE_PROBE_TSC
+#elif defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#define STAGE_PROBE_TSC
+#endif
+
+namespace Igorski {
+namespace Stage {
+
+    enum Type {
+        MODULATION = 0,   // shared formant modulation (attributed to the group leaders channel)
+        PRE_DISTORTION,
+        FORMANT,
+        POST_DISTORTION,
+        CONVERSION,       // conversion of the processed signal into the output buffer
+        LIMITER,          // processes all channels at once (attributed to the first channel)
+        AMOUNT
+    };
+
+    static const char* const NAMES[ AMOUNT ] = {
+        "modulation", "pre distortion", "formant", "post distortion", "conversion", "limiter"
+    };
+
+    // aggregated cycles (and invocations) per stage, per channel
+    // note each channel is only written by the thread processing it, the counters of each
+    // channel start at a cache line boundary so threads processing different channels don't
+    // share cache lines (which would distort the measurements)
+
+    struct alignas( 64 ) ChannelStats {
+        uint64 cycles[ AMOUNT ];
+        uint64 calls[ AMOUNT ];
+    };
+
+    struct Stats {
+        ChannelStats channels[ VST::MAX_CHANNELS ];
+
+        inline void reset()
+        {
+            for ( int c = 0; c < VST::MAX_CHANNELS; ++c ) {
+                for ( int s = 0; s < AMOUNT; ++s ) {
+                    channels[ c ].cycles[ s ] = 0;
+                    channels[ c ].calls[ s ]  = 0;
+                }
+            }
+        }
+    };
+
+    static inline uint64 now()
+    {
+    #ifdef STAGE_PROBE_TSC
+        return ( uint64 ) __rdtsc();
+    #else
+        return ( uint64 ) std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+    #endif
+    }
+
+    class ScopedProbe
+    {
+        public:
+            ScopedProbe( Stats& stats, Type stage, int channel )
+            : _stats( stats.channels[ channel % VST::MAX_CHANNELS ] ), _stage( stage ), _start( now())
+            {
+            }
+
+            ~ScopedProbe()
+            {
+                _stats.cycles[ _stage ] += now() - _start;
+                ++_stats.calls[ _stage ];
+            }
+
+        private:
+            ChannelStats& _stats;
+            Type   _stage;
+            uint64 _start;
+    };
+}
+}
+
+#define STAGE_PROBE_CONCAT_( a, b ) a##b
+#define STAGE_PROBE_CONCAT( a, b ) STAGE_PROBE_CONCAT_( a, b )
+#define STAGE_PROBE( stats, stage, channel ) \
+    Igorski::Stage::ScopedProbe STAGE_PROBE_CONCAT( stageProbe, __LINE__ )( stats, Igorski::Stage::stage, channel )
+
+#else
+
+#define STAGE_PROBE( stats, stage, channel )
+
+#endif
+
+#endif
@@ -23,7 +23,9 @@
 #include "../global.h"
 #include "controller.h"
 #include "uimessagecontroller.h"
+#include "spectrumview.h"
 #include "../paramids.h"
+#include "../cpugovernor.h"
 
 #include "pluginterfaces/base/ibstream.h"
 #include "pluginterfaces/base/ustring.h"
@@ -134,11 +136,51 @@ tresult PLUGIN_API PluginController::initialize( FUnknown* context )
         USTRING( "Distortion pre/post" ), 0, 1, 0, ParameterInfo::kCanAutomate, kDistortionChainId, unitId
     );
 
+    // processing controls (see CpuGovernor)
+
+    parameters.addParameter( new RangeParameter(
+        USTRING( "CPU Budget" ), kCpuBudgetId, USTRING( "%" ),
+        0.f, 1.f, Igorski::CpuGovernor::DEFAULT_BUDGET,
+        0, ParameterInfo::kCanAutomate, unitId
+    ));
+
+    // processing status (reported by the processor, see Quality::Tier)
+
+    StringListParameter* qualityParameter = new StringListParameter(
+        USTRING( "Quality" ), kQualityTierId, nullptr,
+        ParameterInfo::kIsReadOnly | ParameterInfo::kIsList, unitId
+    );
+    qualityParameter->appendString( USTRING( "Low" ));
+    qualityParameter->appendString( USTRING( "Realtime" ));
+    qualityParameter->appendString( USTRING( "Offline" ));
+    parameters.addParameter( qualityParameter );
+
+    // output meters (reported by the processor, see Transformant::updateMeters())
+
+    parameters.addParameter(
+        USTRING( "Output Peak L" ), nullptr, 0, 0, ParameterInfo::kIsReadOnly, kOutputPeakLId, unitId
+    );
+    parameters.addParameter(
+        USTRING( "Output Peak R" ), nullptr, 0, 0, ParameterInfo::kIsReadOnly, kOutputPeakRId, unitId
+    );
+    parameters.addParameter(
+        USTRING( "Output RMS L" ), nullptr, 0, 0, ParameterInfo::kIsReadOnly, kOutputRMSLId, unitId
+    );
+    parameters.addParameter(
+        USTRING( "Output RMS R" ), nullptr, 0, 0, ParameterInfo::kIsReadOnly, kOutputRMSRId, unitId
+    );
+    parameters.addParameter(
+        USTRING( "Limiter Gain" ), nullptr, 0, 1, ParameterInfo::kIsReadOnly, kVuPPMId, unitId
+    );
+
     // initialization
 
     String str( "TRANSFORMANT" );
     str.copyTo16( defaultMessageText, 0, 127 );
 
+    memset( &processStats, 0, sizeof( processStats ));
+    memset( formants, 0, sizeof( formants ));
+
     return result;
 }
 
@@ -194,6 +236,18 @@ tresult PLUGIN_API PluginController::setComponentState( IBStream* state )
         if ( state->read( &savedDistortionChain, sizeof( float )) != kResultOk )
             return kResultFalse;
 
+        // states saved prior to the introduction of the CPU budget don't contain it
+
+        float savedCpuBudget = Igorski::CpuGovernor::DEFAULT_BUDGET;
+        float readCpuBudget  = 0.f;
+        int32 bytesRead      = 0;
+        if ( state->read( &readCpuBudget, sizeof( float ), &bytesRead ) == kResultOk && bytesRead == ( int32 ) sizeof( float )) {
+#if BYTEORDER == kBigEndian
+            SWAP32( readCpuBudget )
+#endif
+            savedCpuBudget = readCpuBudget;
+        }
+
 #if BYTEORDER == kBigEndian
     SWAP32( savedVowelL )
     SWAP32( savedVowelR )
@@ -217,6 +271,7 @@ tresult PLUGIN_API PluginController::setComponentState( IBStream* state )
         setParamNormalized( kDistortionTypeId,  savedDistortionType );
         setParamNormalized( kDriveId,           savedDrive );
         setParamNormalized( kDistortionChainId, savedDistortionChain );
+        setParamNormalized( kCpuBudgetId,       savedCpuBudget );
 
         state->seek( sizeof ( float ), IBStream::kIBSeekCur );
     }
@@ -249,6 +304,23 @@ IController* PluginController::createSubController( UTF8StringPtr name,
     return nullptr;
 }
 
+//------------------------------------------------------------------------
+CView* PluginController::createCustomView( UTF8StringPtr name, const UIAttributes& attributes,
+                                           const IUIDescription* /*description*/,
+                                           VST3Editor* /*editor*/ )
+{
+    if ( UTF8StringView( name ) == "SpectrumView" )
+    {
+        CPoint origin;
+        CPoint size;
+        attributes.getPointAttribute( "origin", origin );
+        attributes.getPointAttribute( "size", size );
+
+        return new SpectrumView( CRect( origin, size ), this );
+    }
+    return nullptr;
+}
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API PluginController::setState( IBStream* state )
 {
@@ -302,6 +374,124 @@ tresult PluginController::receiveText( const char* text )
     return kResultOk;
 }
 
+//------------------------------------------------------------------------
+tresult PLUGIN_API PluginController::notify( IMessage* message )
+{
+    if ( !message )
+        return kInvalidArgument;
+
+    // processing statistics sent in reply to requestProcessStats()
+
+    if ( !strcmp( message->getMessageID(), "ProcessStats" ))
+    {
+        IAttributeList* attributes = message->getAttributes();
+        int64 value;
+        double floatValue;
+        const void* histogram;
+        uint32 size;
+
+        if ( attributes->getInt( "blocks", value ) == kResultOk )
+            processStats.blocks = ( uint32 ) value;
+
+        if ( attributes->getInt( "overruns", value ) == kResultOk )
+            processStats.overruns = ( uint32 ) value;
+
+        if ( attributes->getInt( "worstBlockTime", value ) == kResultOk )
+            processStats.worstBlockTime = ( uint64 ) value;
+
+        if ( attributes->getFloat( "worstLoad", floatValue ) == kResultOk )
+            processStats.worstLoad = ( float ) floatValue;
+
+        if ( attributes->getBinary( "histogram", histogram, size ) == kResultOk && size == sizeof( processStats.histogram ))
+            memcpy( processStats.histogram, histogram, size );
+
+        return kResultOk;
+    }
+
+    // visualisation frames sent in reply to requestVisualisation(), these are analysed
+    // in order so the spectrum is smoothed over all frames, the formants reflect the most recent frame
+
+    if ( !strcmp( message->getMessageID(), "Visualisation" ))
+    {
+        const void* data;
+        uint32 size;
+
+        if ( message->getAttributes()->getBinary( "frames", data, size ) != kResultOk )
+            return kResultOk;
+
+        const Igorski::VisualFeed::Frame* frames = ( const Igorski::VisualFeed::Frame* ) data;
+        uint32 amount = size / sizeof( Igorski::VisualFeed::Frame );
+
+        for ( uint32 i = 0; i < amount; ++i )
+            spectrumAnalyser.analyse( frames[ i ].samples, frames[ i ].sampleRate );
+
+        if ( amount > 0 )
+            memcpy( formants, frames[ amount - 1 ].formants, sizeof( formants ));
+
+        return kResultOk;
+    }
+    return EditControllerEx1::notify( message );
+}
+
+//------------------------------------------------------------------------
+void PluginController::requestProcessStats()
+{
+    if ( IPtr<IMessage> message = owned( allocateMessage()))
+    {
+        message->setMessageID( "ProcessStatsRequest" );
+        sendMessage( message );
+    }
+}
+
+//------------------------------------------------------------------------
+void PluginController::resetProcessStats()
+{
+    if ( IPtr<IMessage> message = owned( allocateMessage()))
+    {
+        message->setMessageID( "ProcessStatsReset" );
+        sendMessage( message );
+    }
+}
+
+//------------------------------------------------------------------------
+Igorski::ProcessStats::Snapshot* PluginController::getProcessStats()
+{
+    return &processStats;
+}
+
+//------------------------------------------------------------------------
+void PluginController::requestVisualisation()
+{
+    if ( IPtr<IMessage> message = owned( allocateMessage()))
+    {
+        message->setMessageID( "VisualisationRequest" );
+        sendMessage( message );
+    }
+}
+
+//------------------------------------------------------------------------
+void PluginController::stopVisualisation()
+{
+    if ( IPtr<IMessage> message = owned( allocateMessage()))
+    {
+        message->setMessageID( "VisualisationStop" );
+        sendMessage( message );
+    }
+    spectrumAnalyser.reset();
+}
+
+//------------------------------------------------------------------------
+Igorski::SpectrumAnalyser* PluginController::getSpectrumAnalyser()
+{
+    return &spectrumAnalyser;
+}
+
+//------------------------------------------------------------------------
+Igorski::VisualFeed::Formants* PluginController::getFormants( int channel )
+{
+    return &formants[ channel ];
+}
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API PluginController::setParamNormalized( ParamID tag, ParamValue value )
 {
@@ -326,6 +516,7 @@ tresult PLUGIN_API PluginController::getParamStringByValue( ParamID tag, ParamVa
         case kDistortionTypeId:
         case kDriveId:
         case kDistortionChainId:
+        case kCpuBudgetId:
         {
             char text[32];
 
@@ -25,6 +25,9 @@
 
 #include "vstgui/plugin-bindings/vst3editor.h"
 #include "public.sdk/source/vst/vsteditcontroller.h"
+#include "../processstats.h"
+#include "../visualfeed.h"
+#include "spectrumanalyser.h"
 
 #include <vector>
 
@@ -66,6 +69,7 @@ class PluginController : public EditControllerEx1, public IMidiMapping, public V
 
         //---from ComponentBase-----
         tresult receiveText( const char* text ) SMTG_OVERRIDE;
+        tresult PLUGIN_API notify( IMessage* message ) SMTG_OVERRIDE;
 
         //---from IMidiMapping-----------------
         tresult PLUGIN_API getMidiControllerAssignment (int32 busIndex, int16 channel,
@@ -75,6 +79,8 @@ class PluginController : public EditControllerEx1, public IMidiMapping, public V
         //---from VST3EditorDelegate-----------
         IController* createSubController( UTF8StringPtr name, const IUIDescription* description,
                                           VST3Editor* editor ) SMTG_OVERRIDE;
+        CView* createCustomView( UTF8StringPtr name, const UIAttributes& attributes,
+                                 const IUIDescription* description, VST3Editor* editor ) SMTG_OVERRIDE;
 
         DELEGATE_REFCOUNT ( EditController )
         tresult PLUGIN_API queryInterface( const char* iid, void** obj ) SMTG_OVERRIDE;
@@ -86,11 +92,32 @@ class PluginController : public EditControllerEx1, public IMidiMapping, public V
         void setDefaultMessageText( String128 text );
         TChar* getDefaultMessageText();
 
+        // request the processing statistics from the processor, the statistics are
+        // updated once the processor replies (see notify())
+
+        void requestProcessStats();
+        void resetProcessStats();
+        Igorski::ProcessStats::Snapshot* getProcessStats();
+
+        // request the visualisation feed from the processor, frames are analysed once the
+        // processor replies (see notify()). The processor only writes the feed while it is
+        // requested, stop the visualisation once it is no longer displayed
+
+        void requestVisualisation();
+        void stopVisualisation();
+        Igorski::SpectrumAnalyser* getSpectrumAnalyser();
+        Igorski::VisualFeed::Formants* getFormants( int channel );
+
     private:
         typedef std::vector<UIMessageController*> UIMessageControllerList;
         UIMessageControllerList uiMessageControllers;
 
         String128 defaultMessageText;
+
+        Igorski::ProcessStats::Snapshot processStats;
+
+        Igorski::SpectrumAnalyser spectrumAnalyser;
+        Igorski::VisualFeed::Formants formants[ Igorski::VisualFeed::CHANNELS ];
 };
 
 //------------------------------------------------------------------------
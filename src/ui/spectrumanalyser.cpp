@@ -0,0 +1,150 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "spectrumanalyser.h"
+#include <math.h>
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+SpectrumAnalyser::SpectrumAnalyser()
+{
+    _window      = new float[ SIZE ];
+    _cosTable    = new float[ BIN_AMOUNT ];
+    _sinTable    = new float[ BIN_AMOUNT ];
+    _bitReversal = new int[ SIZE ];
+    _real        = new float[ SIZE ];
+    _imag        = new float[ SIZE ];
+    _magnitudes  = new float[ BIN_AMOUNT ];
+    _sampleRate  = 44100.f;
+
+    // precalculate the window, twiddle factors and bit reversed indices
+
+    int bits = 0;
+    while (( 1 << bits ) < SIZE ) {
+        ++bits;
+    }
+
+    for ( int i = 0; i < SIZE; ++i ) {
+        _window[ i ] = 0.5f - 0.5f * cosf( VST::TWO_PI * ( float ) i / ( float ) ( SIZE - 1 ));
+
+        int reversed = 0;
+        for ( int b = 0; b < bits; ++b ) {
+            reversed |= (( i >> b ) & 1 ) << ( bits - 1 - b );
+        }
+        _bitReversal[ i ] = reversed;
+    }
+
+    for ( int i = 0; i < BIN_AMOUNT; ++i ) {
+        _cosTable[ i ] =  cosf( VST::TWO_PI * ( float ) i / ( float ) SIZE );
+        _sinTable[ i ] = -sinf( VST::TWO_PI * ( float ) i / ( float ) SIZE );
+    }
+    reset();
+}
+
+SpectrumAnalyser::~SpectrumAnalyser()
+{
+    delete[] _window;
+    delete[] _cosTable;
+    delete[] _sinTable;
+    delete[] _bitReversal;
+    delete[] _real;
+    delete[] _imag;
+    delete[] _magnitudes;
+}
+
+/* public methods */
+
+void SpectrumAnalyser::analyse( const float* samples, float sampleRate )
+{
+    _sampleRate = sampleRate;
+
+    for ( int i = 0; i < SIZE; ++i ) {
+        int index = _bitReversal[ i ];
+        _real[ index ] = samples[ i ] * _window[ i ];
+        _imag[ index ] = 0.f;
+    }
+    transform();
+
+    // the Hann window halves the amplitude, normalize so a full scale sine reads 0 dB
+
+    const float scale = 4.f / ( float ) SIZE;
+
+    for ( int i = 0; i < BIN_AMOUNT; ++i ) {
+        float magnitude = sqrtf( _real[ i ] * _real[ i ] + _imag[ i ] * _imag[ i ]) * scale;
+        float dB        = magnitude > 0.f ? 20.f * log10f( magnitude ) : MIN_DB;
+
+        if ( dB < MIN_DB ) {
+            dB = MIN_DB;
+        }
+        // rise immediately, decay smoothly
+
+        _magnitudes[ i ] = dB > _magnitudes[ i ] ? dB : _magnitudes[ i ] * SMOOTHING + dB * ( 1.f - SMOOTHING );
+    }
+}
+
+float SpectrumAnalyser::getMagnitude( int bin )
+{
+    return _magnitudes[ bin ];
+}
+
+float SpectrumAnalyser::getBinFrequency( int bin )
+{
+    return ( float ) bin * _sampleRate / ( float ) SIZE;
+}
+
+void SpectrumAnalyser::reset()
+{
+    for ( int i = 0; i < BIN_AMOUNT; ++i ) {
+        _magnitudes[ i ] = MIN_DB;
+    }
+}
+
+/* private methods */
+
+void SpectrumAnalyser::transform()
+{
+    // iterative in-place radix-2 FFT, expects the input in bit reversed order
+
+    for ( int size = 2; size <= SIZE; size <<= 1 ) {
+        int halfSize = size >> 1;
+        int step     = SIZE / size;
+
+        for ( int i = 0; i < SIZE; i += size ) {
+            for ( int j = 0; j < halfSize; ++j ) {
+                int   k  = j * step;
+                int   a  = i + j;
+                int   b  = a + halfSize;
+                float tr = _real[ b ] * _cosTable[ k ] - _imag[ b ] * _sinTable[ k ];
+                float ti = _real[ b ] * _sinTable[ k ] + _imag[ b ] * _cosTable[ k ];
+
+                _real[ b ] = _real[ a ] - tr;
+                _imag[ b ] = _imag[ a ] - ti;
+                _real[ a ] += tr;
+                _imag[ a ] += ti;
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,79 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __SPECTRUMANALYSER_H_INCLUDED__
+#define __SPECTRUMANALYSER_H_INCLUDED__
+
+#include "../visualfeed.h"
+
+namespace Igorski {
+
+/**
+ * SpectrumAnalyser calculates the magnitude spectrum of the frames provided by the
+ * VisualFeed. The analysis is performed by the editor on the UI thread.
+ *
+ * Each frame is windowed (Hann) and transformed using a radix-2 FFT. The magnitudes
+ * (in dB) are smoothed across consecutive frames to keep the display legible.
+ */
+class SpectrumAnalyser
+{
+    public:
+        static const int SIZE       = VisualFeed::FRAME_SIZE; // must be a power of two
+        static const int BIN_AMOUNT = SIZE / 2;
+
+        static constexpr float MIN_DB    = -96.f;
+        static constexpr float SMOOTHING = 0.6f; // amount of the previous magnitude retained per frame
+
+        SpectrumAnalyser();
+        ~SpectrumAnalyser();
+
+        // analyses SIZE samples at given sample rate
+
+        void analyse( const float* samples, float sampleRate );
+
+        // the smoothed magnitude (in dB, clamped to MIN_DB) of given bin
+
+        float getMagnitude( int bin );
+
+        // the center frequency (in Hz) of given bin, for the last analysed sample rate
+
+        float getBinFrequency( int bin );
+
+        // resets the magnitudes to MIN_DB
+
+        void reset();
+
+    private:
+        float* _window;
+        float* _cosTable;
+        float* _sinTable;
+        int*   _bitReversal;
+        float* _real;
+        float* _imag;
+        float* _magnitudes;
+        float  _sampleRate;
+
+        void transform();
+};
+}
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "spectrumview.h"
+#include "controller.h"
+#include "spectrumanalyser.h"
+
+#include "vstgui/lib/cdrawcontext.h"
+
+#include <math.h>
+
+namespace Steinberg {
+namespace Vst {
+
+using namespace VSTGUI;
+
+// displayed frequency range (in Hz)
+
+static const float MIN_FREQUENCY = 50.f;
+static const float MAX_FREQUENCY = 12000.f;
+
+// the displayed range of the spectrum (in dB)
+
+static const float MAX_DB = 0.f;
+
+//------------------------------------------------------------------------
+SpectrumView::SpectrumView( const CRect& size, PluginController* controller )
+: CView( size )
+, controller( controller )
+{
+    setMouseEnabled( false );
+}
+
+//------------------------------------------------------------------------
+bool SpectrumView::attached( CView* parent )
+{
+    if ( !CView::attached( parent ))
+        return false;
+
+    // request the feed at the display rate, all frames written since
+    // the previous request are delivered in a single reply
+
+    timer = makeOwned<CVSTGUITimer>([ this ]( CVSTGUITimer* )
+    {
+        controller->requestVisualisation();
+        invalid();
+    }, FRAME_INTERVAL );
+
+    return true;
+}
+
+//------------------------------------------------------------------------
+bool SpectrumView::removed( CView* parent )
+{
+    if ( timer )
+    {
+        timer->stop();
+        timer = nullptr;
+    }
+    // the processor stops writing the feed until it is requested again
+
+    controller->stopVisualisation();
+
+    return CView::removed( parent );
+}
+
+//------------------------------------------------------------------------
+void SpectrumView::draw( CDrawContext* context )
+{
+    const CRect bounds = getViewSize();
+
+    Igorski::SpectrumAnalyser* analyser = controller->getSpectrumAnalyser();
+    const float minDB   = Igorski::SpectrumAnalyser::MIN_DB;
+    const CCoord height = bounds.getHeight();
+
+    context->setDrawMode( kAntiAliasing );
+    context->setLineWidth( 1 );
+
+    // formant frequencies of each channel, their opacity follows the formant amplitude
+
+    for ( int c = 0; c < Igorski::VisualFeed::CHANNELS; ++c )
+    {
+        Igorski::VisualFeed::Formants* formants = controller->getFormants( c );
+
+        for ( int i = 0; i < Igorski::VisualFeed::FORMANT_AMOUNT; ++i )
+        {
+            float amplitude = fminf( 1.f, fmaxf( 0.f, formants->amplitudes[ i ]));
+            CCoord x = frequencyToX( formants->frequencies[ i ], bounds );
+
+            if ( amplitude <= 0.f || x < bounds.left || x > bounds.right )
+                continue;
+
+            context->setFrameColor( CColor( 255, 255, 255, ( uint8_t ) ( 48 + amplitude * 127 )));
+            context->drawLine( CPoint( x, bounds.top ), CPoint( x, bounds.bottom ));
+        }
+    }
+
+    // the spectrum as connected line segments, skipping bins outside of the displayed range
+
+    CDrawContext::LineList lines;
+    CPoint previous;
+    bool hasPrevious = false;
+
+    for ( int i = 1; i < Igorski::SpectrumAnalyser::BIN_AMOUNT; ++i )
+    {
+        float frequency = analyser->getBinFrequency( i );
+
+        if ( frequency < MIN_FREQUENCY )
+            continue;
+
+        if ( frequency > MAX_FREQUENCY )
+            break;
+
+        float level = ( analyser->getMagnitude( i ) - minDB ) / ( MAX_DB - minDB );
+        level = fminf( 1.f, fmaxf( 0.f, level ));
+
+        CPoint point( frequencyToX( frequency, bounds ), bounds.bottom - level * height );
+
+        if ( hasPrevious )
+            lines.push_back( CDrawContext::LinePair( previous, point ));
+
+        previous    = point;
+        hasPrevious = true;
+    }
+
+    if ( !lines.empty())
+    {
+        context->setFrameColor( CColor( 236, 43, 44, 255 )); // #ec2b2c
+        context->drawLines( lines );
+    }
+    setDirty( false );
+}
+
+//------------------------------------------------------------------------
+CCoord SpectrumView::frequencyToX( float frequency, const CRect& bounds )
+{
+    float ratio = logf( frequency / MIN_FREQUENCY ) / logf( MAX_FREQUENCY / MIN_FREQUENCY );
+    return bounds.left + ratio * bounds.getWidth();
+}
+
+//------------------------------------------------------------------------
+} // namespace Vst
+} // namespace Steinberg
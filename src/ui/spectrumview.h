@@ -0,0 +1,64 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __SPECTRUMVIEW_HEADER__
+#define __SPECTRUMVIEW_HEADER__
+
+#include "vstgui/lib/cview.h"
+#include "vstgui/lib/cvstguitimer.h"
+
+namespace Steinberg {
+namespace Vst {
+
+class PluginController;
+
+//------------------------------------------------------------------------
+// SpectrumView draws the spectrum of the output along with the current
+// formant frequencies. While attached, the view periodically requests the
+// visualisation feed from the processor (see PluginController::requestVisualisation())
+//------------------------------------------------------------------------
+class SpectrumView : public VSTGUI::CView
+{
+    public:
+        static const int FRAME_INTERVAL = 33; // in milliseconds (~30 fps)
+
+        SpectrumView( const VSTGUI::CRect& size, PluginController* controller );
+
+        void draw( VSTGUI::CDrawContext* context ) override;
+
+        bool attached( VSTGUI::CView* parent ) override;
+        bool removed( VSTGUI::CView* parent ) override;
+
+    private:
+        PluginController* controller;
+        VSTGUI::SharedPointer<VSTGUI::CVSTGUITimer> timer;
+
+        // maps given frequency (in Hz) onto a logarithmic horizontal position within given bounds
+
+        VSTGUI::CCoord frequencyToX( float frequency, const VSTGUI::CRect& bounds );
+};
+
+//------------------------------------------------------------------------
+} // namespace Vst
+} // namespace Steinberg
+
+#endif
@@ -0,0 +1,98 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "visualfeed.h"
+#include <string.h>
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+VisualFeed::VisualFeed()
+{
+    memset( &_pending, 0, sizeof( Frame ));
+
+    _position          = 0;
+    _decimationCounter = 0;
+    _sum               = 0.0;
+
+    _enabled.store( false );
+}
+
+VisualFeed::~VisualFeed()
+{
+
+}
+
+/* public methods */
+
+void VisualFeed::setEnabled( bool enabled )
+{
+    if ( !enabled ) {
+        // discard the unread frames
+        _frames.clear();
+    }
+    _enabled.store( enabled, std::memory_order_relaxed );
+}
+
+bool VisualFeed::isEnabled()
+{
+    return _enabled.load( std::memory_order_relaxed );
+}
+
+VisualFeed::Formants* VisualFeed::getFormants( int channel )
+{
+    return &_pending.formants[ channel ];
+}
+
+int VisualFeed::read( Frame* frames, int maxFrames )
+{
+    int amount = 0;
+    Frame* frame;
+
+    while ( amount < maxFrames && ( frame = _frames.peek()) != nullptr ) {
+        memcpy( &frames[ amount++ ], frame, sizeof( Frame ));
+
+        // release the read frame to the audio thread
+
+        _frames.release();
+    }
+    return amount;
+}
+
+/* private methods */
+
+void VisualFeed::publish( float sampleRate )
+{
+    Frame* frame = _frames.reserve();
+
+    if ( frame == nullptr ) {
+        return; // the consumer is lagging behind, drop the frame
+    }
+    _pending.sampleRate = sampleRate;
+
+    memcpy( frame, &_pending, sizeof( Frame ));
+
+    _frames.publish();
+}
+
+}
@@ -0,0 +1,107 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __VISUALFEED_H_INCLUDED__
+#define __VISUALFEED_H_INCLUDED__
+
+#include "global.h"
+#include "spscring.h"
+#include <atomic>
+
+namespace Igorski {
+
+/**
+ * VisualFeed hands a decimated copy of the output (mixed down to mono) along with the
+ * state of the formant filters from the audio thread to the editor, for visualisation.
+ *
+ * The audio thread collects the output into frames of FRAME_SIZE samples, which are
+ * published into a lock-free ring buffer. The frames are read on the main thread (see
+ * Transformant::notify()) and sent to the controller in batches, where the spectrum is
+ * analysed (no analysis is performed on the audio thread).
+ *
+ * The feed has a single producer (the audio thread) and a single consumer. When the
+ * ring buffer is full, completed frames are dropped. While disabled (e.g. when no editor
+ * is open) writing to the feed returns immediately.
+ */
+class VisualFeed
+{
+    public:
+        static const int FRAME_SIZE     = 1024; // in (decimated) samples
+        static const int DECIMATION     = 2;    // the output is decimated by this factor
+        static const int CAPACITY       = 8;    // in frames, must be a power of two
+        static const int CHANNELS       = 2;    // the amount of formant filters described by a frame
+        static const int FORMANT_AMOUNT = 4;    // equal to FormantFilter::VOWEL_AMOUNT
+
+        struct Formants {
+            float vowel; // including the LFO modulation
+            float frequencies[ FORMANT_AMOUNT ]; // in Hz
+            float amplitudes [ FORMANT_AMOUNT ];
+        };
+
+        struct Frame {
+            float    sampleRate; // of the decimated samples
+            Formants formants[ CHANNELS ];
+            float    samples[ FRAME_SIZE ];
+        };
+
+        VisualFeed();
+        ~VisualFeed();
+
+        // enable the feed once a consumer is present, disabling it discards the unread frames
+        // these should be invoked by the consumer
+
+        void setEnabled( bool enabled );
+        bool isEnabled();
+
+        // the state of the formant filters of the frame currently being written, should be
+        // updated by the audio thread prior to write()
+
+        Formants* getFormants( int channel );
+
+        // collects the output of given buffers (the first CHANNELS channels are mixed down)
+        // should only be invoked by the audio thread
+
+        template <typename SampleType>
+        void write( SampleType** buffer, int numChannels, int bufferSize, float sampleRate );
+
+        // copies up to maxFrames of the published frames into given frames, oldest
+        // first, returning the amount of copied frames. This should only be invoked by the consumer
+
+        int read( Frame* frames, int maxFrames );
+
+    private:
+        SpscRing<Frame, CAPACITY> _frames;
+        Frame _pending;
+
+        int    _position;     // in the pending frame
+        int    _decimationCounter;
+        double _sum;
+
+        std::atomic<bool> _enabled;
+
+        void publish( float sampleRate );
+};
+}
+
+#include "visualfeed.tcc"
+
+#endif
@@ -0,0 +1,64 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+namespace Igorski
+{
+template <typename SampleType>
+void VisualFeed::write( SampleType** buffer, int numChannels, int bufferSize, float sampleRate )
+{
+    if ( !_enabled.load( std::memory_order_relaxed )) {
+        // start collecting a new frame once enabled
+        _position          = 0;
+        _decimationCounter = 0;
+        _sum               = 0.0;
+        return;
+    }
+
+    int channels = numChannels < CHANNELS ? numChannels : CHANNELS;
+    if ( channels == 0 ) {
+        return;
+    }
+    double scale = 1.0 / ( channels * DECIMATION );
+
+    // the decimated samples are the average of DECIMATION samples of the mono mix
+
+    for ( int i = 0; i < bufferSize; ++i ) {
+        for ( int c = 0; c < channels; ++c ) {
+            _sum += buffer[ c ][ i ];
+        }
+
+        if ( ++_decimationCounter < DECIMATION ) {
+            continue;
+        }
+        _pending.samples[ _position ] = ( float ) ( _sum * scale );
+
+        _sum               = 0.0;
+        _decimationCounter = 0;
+
+        if ( ++_position == FRAME_SIZE ) {
+            publish( sampleRate / DECIMATION );
+            _position = 0;
+        }
+    }
+}
+
+}
@@ -24,6 +24,7 @@
 #include "vst.h"
 #include "paramids.h"
 #include "calc.h"
+#include "rtsafety.h"
 
 #include "public.sdk/source/vst/vstaudioprocessoralgo.h"
 
@@ -33,7 +34,12 @@
 #include "pluginterfaces/vst/ivstparameterchanges.h"
 #include "pluginterfaces/vst/vstpresetkeys.h"
 
+#include <algorithm>
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
 
 namespace Igorski {
 
@@ -51,15 +57,33 @@ Transformant::Transformant()
 , fDistortionType( 0.f )
 , fDrive( 0.f )
 , fDistortionChain( 0.f )
+, fCpuBudget( CpuGovernor::DEFAULT_BUDGET )
 , pluginProcess( nullptr )
-// , outputGainOld( 0.f )
+, meterSamples( 0 )
 , currentProcessMode( -1 ) // -1 means not initialized
+, reportedQualityTier( -1 )
+, logger( nullptr )
 {
     // register its editor class (the same as used in vstentry.cpp)
     setControllerClass( VST::ControllerUID );
 
-    // should be created on setupProcessing, this however doesn't fire for Audio Unit using auval?
+    parameters.set( kVowelLId,          fVowelL );
+    parameters.set( kVowelRId,          fVowelR );
+    parameters.set( kVowelSyncId,       fVowelSync );
+    parameters.set( kLFOVowelLId,       fLFOVowelL );
+    parameters.set( kLFOVowelRId,       fLFOVowelR );
+    parameters.set( kLFOVowelLDepthId,  fLFOVowelLDepth );
+    parameters.set( kLFOVowelRDepthId,  fLFOVowelRDepth );
+    parameters.set( kDistortionTypeId,  fDistortionType );
+    parameters.set( kDriveId,           fDrive );
+    parameters.set( kDistortionChainId, fDistortionChain );
+    parameters.set( kCpuBudgetId,       fCpuBudget );
+
+    // created up front as setupProcessing doesn't fire for Audio Unit using auval?
+    // setupProcessing will reconfigure this instance in place for the actual setup
     pluginProcess = new PluginProcess( 2, 44100.f );
+
+    resetMeters();
 }
 
 //------------------------------------------------------------------------
@@ -67,6 +91,7 @@ Transformant::~Transformant()
 {
     // free all allocated resources
     delete pluginProcess;
+    delete logger;
 }
 
 //------------------------------------------------------------------------
@@ -85,13 +110,23 @@ tresult PLUGIN_API Transformant::initialize( FUnknown* context )
     //---create Event In/Out buses (1 bus with only 1 channel)------
     addEventInput( STR16( "Event In" ), 1 );
 
+    // log diagnostics when a log file has been specified
+
+    const char* logFile = getenv( "TRANSFORMANT_LOG_FILE" );
+
+    if ( logFile != nullptr && logger == nullptr ) {
+        logger = new Logger( logFile );
+    }
+
     return kResultOk;
 }
 
 //------------------------------------------------------------------------
 tresult PLUGIN_API Transformant::terminate()
 {
-    // nothing to do here yet...except calling our parent terminate
+    delete logger;
+    logger = nullptr;
+
     return AudioEffect::terminate();
 }
 
@@ -103,8 +138,11 @@ tresult PLUGIN_API Transformant::setActive (TBool state)
     else
         sendTextMessage( "Transformant::setActive (false)" );
 
-    // reset output level meter
-    // outputGainOld = 0.f;
+    // reset output level meters
+    resetMeters();
+
+    // (re)report the quality tier upon the next process cycle
+    reportedQualityTier = -1;
 
     // call our parent setActive
     return AudioEffect::setActive( state );
@@ -113,6 +151,11 @@ tresult PLUGIN_API Transformant::setActive (TBool state)
 //------------------------------------------------------------------------
 tresult PLUGIN_API Transformant::process( ProcessData& data )
 {
+    // in diagnostic builds, report realtime unsafe calls made while processing (see rtsafety.h)
+    // offline rendering is not bound by a deadline and may use blocking calls (e.g. the worker pool)
+
+    RT_SAFETY_SCOPE( processSetup.processMode != kOffline );
+
     // In this example there are 4 steps:
     // 1) Read inputs parameters coming from host (in order to adapt our model values)
     // 2) Read inputs events coming from host (note on/off events)
@@ -137,50 +180,24 @@ tresult PLUGIN_API Transformant::process( ProcessData& data )
                     continue;
                 }
 
-                switch ( paramQueue->getParameterId())
-                {
-                    case kVowelLId:
-                        fVowelL = ( float ) value;
-                        break;
-
-                    case kVowelRId:
-                        fVowelR = ( float ) value;
-                        break;
-
-                    case kVowelSyncId:
-                        fVowelSync = ( float ) value;
-                        break;
-
-                    case kLFOVowelLId:
-                        fLFOVowelL = ( float ) value;
-                        break;
-
-                    case kLFOVowelRId:
-                        fLFOVowelR = ( float ) value;
-                        break;
-
-                    case kLFOVowelLDepthId:
-                        fLFOVowelLDepth = ( float ) value;
-                        break;
-
-                    case kLFOVowelRDepthId:
-                        fLFOVowelRDepth = ( float ) value;
-                        break;
+                parameters.set( paramQueue->getParameterId(), ( float ) value );
+            }
+        }
+    }
+    // apply the changed parameters (once, regardless of the amount of changes)
+    syncModel();
 
-                    case kDistortionTypeId:
-                        fDistortionType = ( float ) value;
-                        break;
+    // report the active quality tier to the controller when it has changed
 
-                    case kDriveId:
-                        fDrive = ( float ) value;
-                        break;
+    int32 qualityTier = ( int32 ) pluginProcess->getQuality();
+    IParameterChanges* outParamChanges = data.outputParameterChanges;
 
-                    case kDistortionChainId:
-                        fDistortionChain = ( float ) value;
-                        break;
-                }
-                syncModel();
-            }
+    if ( outParamChanges && qualityTier != reportedQualityTier ) {
+        int32 index = 0;
+        IParamValueQueue* paramQueue = outParamChanges->addParameterData( kQualityTierId, index );
+        if ( paramQueue ) {
+            paramQueue->addPoint( 0, Quality::toNormalized(( Quality::Tier ) qualityTier ), index );
+            reportedQualityTier = qualityTier;
         }
     }
 
@@ -205,11 +222,36 @@ tresult PLUGIN_API Transformant::process( ProcessData& data )
     void** in  = getChannelBuffersPointer( processSetup, data.inputs [ 0 ] );
     void** out = getChannelBuffersPointer( processSetup, data.outputs[ 0 ] );
 
+    bool isDoublePrecision = data.symbolicSampleSize == kSample64;
+
+    // the silence flags are a bitmask where each bit represents a channel
+    // (shifting by the full width of the mask is undefined, hence the 64 channel case)
+
+    uint64 inChannelMask  = numInChannels  >= 64 ? ~( uint64 ) 0 : (( uint64 ) 1 << numInChannels ) - 1;
+    uint64 outChannelMask = numOutChannels >= 64 ? ~( uint64 ) 0 : (( uint64 ) 1 << numOutChannels ) - 1;
+    uint64 inSilenceFlags = data.inputs[ 0 ].silenceFlags & inChannelMask;
+
+    // when all input is silent and the processors have settled, there is nothing to process
+
+    if ( inSilenceFlags == inChannelMask && !pluginProcess->hasTail()) {
+        for ( int32 c = 0; c < numOutChannels; ++c ) {
+            memset( out[ c ], 0, sampleFramesSize );
+        }
+        pluginProcess->skip( data.numSamples );
+        data.outputs[ 0 ].silenceFlags = outChannelMask;
+
+        updateMeters( outParamChanges, data.numSamples );
+
+        if ( visualFeed.isEnabled()) {
+            writeVisualFeed( out, numOutChannels, data.numSamples, isDoublePrecision );
+        }
+        return kResultOk;
+    }
+
     // process the incoming sound!
+    // the processing time is measured (in realtime: against the deadline of the block)
 
-    bool isDoublePrecision = data.symbolicSampleSize == kSample64;
-    bool isSilentInput  = data.inputs[ 0 ].silenceFlags != 0;
-    bool isSilentOutput = false;
+    std::chrono::steady_clock::time_point processStart = std::chrono::steady_clock::now();
 
     if ( isDoublePrecision ) {
         // 64-bit samples, e.g. Reaper64
@@ -217,9 +259,6 @@ tresult PLUGIN_API Transformant::process( ProcessData& data )
             ( double** ) in, ( double** ) out, numInChannels, numOutChannels,
             data.numSamples, sampleFramesSize
         );
-        if ( isSilentInput ) {
-            isSilentOutput = pluginProcess->isBufferSilent(( double** ) out, numOutChannels, data.numSamples );
-        }
     }
     else {
         // 32-bit samples, e.g. Ableton Live, Bitwig Studio... (oddly enough also when 64-bit?)
@@ -227,27 +266,52 @@ tresult PLUGIN_API Transformant::process( ProcessData& data )
             ( float** ) in, ( float** ) out, numInChannels, numOutChannels,
             data.numSamples, sampleFramesSize
         );
-        if ( isSilentInput ) {
-            isSilentOutput = pluginProcess->isBufferSilent(( float** ) out, numOutChannels, data.numSamples );
+    }
+
+    std::chrono::nanoseconds processingTime = std::chrono::steady_clock::now() - processStart;
+
+    bool isRealtime = currentProcessMode == kRealtime;
+    uint64 deadline = isRealtime ? ( uint64 ) ( 1.0e9 * data.numSamples / processSetup.sampleRate ) : 0;
+
+    processStats.record(( uint64 ) processingTime.count(), data.numSamples, deadline );
+
+    if ( isRealtime ) {
+        Quality::Tier tier = governor.update( processingTime.count() / 1.0e9, data.numSamples, processSetup.sampleRate );
+
+        if ( logger != nullptr ) {
+            if (( uint64 ) processingTime.count() > deadline ) {
+                logger->log( "block exceeded its deadline, processing time in ns:", ( int ) processingTime.count());
+            }
+            if ( tier != pluginProcess->getQuality()) {
+                logger->log( "quality tier changed to", ( int ) tier );
+            }
         }
+        pluginProcess->setQuality( tier );
     }
 
     // output flags
-   
-    data.outputs[ 0 ].silenceFlags = isSilentOutput ? (( uint64 ) 1 << numOutChannels ) - 1 : 0;
- 
-    // float outputGain = pluginProcess->limiter->getLinearGR();
+    // derived from the analysis of the output made during processing (see PluginProcess::process())
+
+    uint64 outSilenceFlags = 0;
+
+    for ( int32 c = 0; c < numOutChannels && c < 64; ++c ) {
+        if ( pluginProcess->isOutputSilent( c )) {
+            outSilenceFlags |= ( uint64 ) 1 << c;
+        }
+    }
+    data.outputs[ 0 ].silenceFlags = outSilenceFlags;
+
     //---4) Write output parameter changes-----------
-    // IParameterChanges* outParamChanges = data.outputParameterChanges;
-    // // a new value of VuMeter will be sent to the host
-    // // (the host will send it back in sync to our controller for updating our editor)
-    // if ( !isDoublePrecision && outParamChanges && outputGainOld != outputGain ) {
-    //     int32 index = 0;
-    //     IParamValueQueue* paramQueue = outParamChanges->addParameterData( kVuPPMId, index );
-    //     if ( paramQueue )
-    //         paramQueue->addPoint( 0, outputGain, index );
-    // }
-    // outputGainOld = outputGain;
+    // the output meters are sent to the host (which will send them back
+    // in sync to our controller for updating our editor)
+
+    updateMeters( outParamChanges, data.numSamples );
+
+    // hand the output to the editor for visualisation (only while it is open)
+
+    if ( visualFeed.isEnabled()) {
+        writeVisualFeed( out, numOutChannels, data.numSamples, isDoublePrecision );
+    }
 
     return kResultOk;
 }
@@ -308,6 +372,18 @@ tresult PLUGIN_API Transformant::setState( IBStream* state )
     if ( state->read( &savedDistortionChain, sizeof ( float )) != kResultOk )
         return kResultFalse;
 
+    // states saved prior to the introduction of the CPU budget don't contain it
+
+    float savedCpuBudget = CpuGovernor::DEFAULT_BUDGET;
+    float readCpuBudget  = 0.f;
+    int32 bytesRead      = 0;
+    if ( state->read( &readCpuBudget, sizeof ( float ), &bytesRead ) == kResultOk && bytesRead == ( int32 ) sizeof( float )) {
+#if BYTEORDER == kBigEndian
+        SWAP32( readCpuBudget )
+#endif
+        savedCpuBudget = readCpuBudget;
+    }
+
 #if BYTEORDER == kBigEndian
     SWAP32( savedVowelL )
     SWAP32( savedVowelR )
@@ -321,18 +397,22 @@ tresult PLUGIN_API Transformant::setState( IBStream* state )
     SWAP32( savedDistortionChain )
 #endif
 
-    fVowelL          = savedVowelL;
-    fVowelR          = savedVowelR;
-    fVowelSync       = savedVowelSync;
-    fLFOVowelL       = savedLFOVowelL;
-    fLFOVowelR       = savedLFOVowelR;
-    fLFOVowelLDepth  = savedLFOVowelLDepth;
-    fLFOVowelRDepth  = savedLFOVowelRDepth;
-    fDistortionType  = savedDistortionType;
-    fDrive           = savedDrive;
-    fDistortionChain = savedDistortionChain;
-
-    syncModel();
+    // the restored values are applied to the model by the next process() call
+    // (all at once, as they are written in a single update)
+
+    parameters.beginUpdate();
+    parameters.set( kVowelLId,          savedVowelL );
+    parameters.set( kVowelRId,          savedVowelR );
+    parameters.set( kVowelSyncId,       savedVowelSync );
+    parameters.set( kLFOVowelLId,       savedLFOVowelL );
+    parameters.set( kLFOVowelRId,       savedLFOVowelR );
+    parameters.set( kLFOVowelLDepthId,  savedLFOVowelLDepth );
+    parameters.set( kLFOVowelRDepthId,  savedLFOVowelRDepth );
+    parameters.set( kDistortionTypeId,  savedDistortionType );
+    parameters.set( kDriveId,           savedDrive );
+    parameters.set( kDistortionChainId, savedDistortionChain );
+    parameters.set( kCpuBudgetId,       savedCpuBudget );
+    parameters.endUpdate();
 
     // Example of using the IStreamAttributes interface
     FUnknownPtr<IStreamAttributes> stream (state);
@@ -372,16 +452,19 @@ tresult PLUGIN_API Transformant::getState( IBStream* state )
 {
     // here we need to save the model
 
-    float toSaveVowelL          = fVowelL;
-    float toSaveVowelR          = fVowelR;
-    float toSaveVowelSync       = fVowelSync;
-    float toSaveLFOVowelL       = fLFOVowelL;
-    float toSaveLFOVowelR       = fLFOVowelR;
-    float toSaveLFOVowelLDepth  = fLFOVowelLDepth;
-    float toSaveLFOVowelRDepth  = fLFOVowelRDepth;
-    float toSaveDistortionType  = fDistortionType;
-    float toSaveDrive           = fDrive;
-    float toSaveDistortionChain = fDistortionChain;
+    // the store holds the most recent values (which might not have been applied to the model yet)
+
+    float toSaveVowelL          = parameters.get( kVowelLId );
+    float toSaveVowelR          = parameters.get( kVowelRId );
+    float toSaveVowelSync       = parameters.get( kVowelSyncId );
+    float toSaveLFOVowelL       = parameters.get( kLFOVowelLId );
+    float toSaveLFOVowelR       = parameters.get( kLFOVowelRId );
+    float toSaveLFOVowelLDepth  = parameters.get( kLFOVowelLDepthId );
+    float toSaveLFOVowelRDepth  = parameters.get( kLFOVowelRDepthId );
+    float toSaveDistortionType  = parameters.get( kDistortionTypeId );
+    float toSaveDrive           = parameters.get( kDriveId );
+    float toSaveDistortionChain = parameters.get( kDistortionChainId );
+    float toSaveCpuBudget       = parameters.get( kCpuBudgetId );
 
 #if BYTEORDER == kBigEndian
     SWAP32( toSaveVowelL );
@@ -394,6 +477,7 @@ tresult PLUGIN_API Transformant::getState( IBStream* state )
     SWAP32( toSaveDistortionType );
     SWAP32( toSaveDrive );
     SWAP32( toSaveDriveDepth );
+    SWAP32( toSaveCpuBudget );
 #endif
 
     state->write( &toSaveVowelL         , sizeof( float ));
@@ -406,6 +490,7 @@ tresult PLUGIN_API Transformant::getState( IBStream* state )
     state->write( &toSaveDistortionType , sizeof( float ));
     state->write( &toSaveDrive          , sizeof( float ));
     state->write( &toSaveDistortionChain, sizeof( float ));
+    state->write( &toSaveCpuBudget      , sizeof( float ));
 
     return kResultOk;
 }
@@ -418,12 +503,37 @@ tresult PLUGIN_API Transformant::setupProcessing( ProcessSetup& newSetup )
     // here we keep a trace of the processing mode (offline,...) for example.
     currentProcessMode = newSetup.processMode;
 
-    // spotted to fire multiple times...
+    // spotted to fire multiple times... the processor is updated in place
+    // (and only where the setup has actually changed) instead of being recreated
 
-    if ( pluginProcess != nullptr )
-        delete pluginProcess;
+    // one formant filter is allocated for each channel of the negotiated bus arrangement
+
+    int32 amountOfChannels = 2;
+    AudioBus* bus = FCast<AudioBus>( audioInputs.at( 0 ));
+    if ( bus ) {
+        amountOfChannels = SpeakerArr::getChannelCount( bus->getArrangement());
+    }
 
-    pluginProcess = new PluginProcess( 2, newSetup.sampleRate );
+    int previousAmountOfChannels = pluginProcess->getFormantFilterAmount();
+
+    pluginProcess->reconfigure( newSetup.sampleRate, newSetup.maxSamplesPerBlock, amountOfChannels );
+
+    // newly created filters inherit the settings of an existing filter, which needn't be the
+    // settings of their side (e.g. the right filter cloned from the left one when growing from mono),
+    // reapply all parameters so each filter has the settings matching its channel
+
+    if ( amountOfChannels != previousAmountOfChannels ) {
+        parameters.invalidate();
+    }
+    pluginProcess->setOfflineProcessing( currentProcessMode == kOffline );
+
+    // heavier processing is reserved for rendering, where there is no realtime deadline
+    // in realtime, the governor may lower the quality when the CPU budget is exceeded
+
+    Quality::Tier qualityTier = ( currentProcessMode == kOffline ) ? Quality::OFFLINE : Quality::REALTIME;
+
+    governor.setMaximumTier( qualityTier );
+    pluginProcess->setQuality( qualityTier );
 
     syncModel();
 
@@ -433,8 +543,11 @@ tresult PLUGIN_API Transformant::setupProcessing( ProcessSetup& newSetup )
 //------------------------------------------------------------------------
 tresult PLUGIN_API Transformant::setBusArrangements( SpeakerArrangement* inputs, int32 numIns, SpeakerArrangement* outputs, int32 numOuts )
 {
-    bool isMonoInOut   = SpeakerArr::getChannelCount( inputs[ 0 ]) == 1 && SpeakerArr::getChannelCount( outputs[ 0 ]) == 1;
-    bool isStereoInOut = SpeakerArr::getChannelCount( inputs[ 0 ]) == 2 && SpeakerArr::getChannelCount( outputs[ 0 ]) == 2;
+    int32 numInChannels  = SpeakerArr::getChannelCount( inputs[ 0 ]);
+    int32 numOutChannels = SpeakerArr::getChannelCount( outputs[ 0 ]);
+
+    bool isMonoInOut   = numInChannels == 1 && numOutChannels == 1;
+    bool isStereoInOut = numInChannels == 2 && numOutChannels == 2;
 #ifdef BUILD_AUDIO_UNIT
     if ( !isMonoInOut && !isStereoInOut ) {
         return AudioEffect::setBusArrangements( inputs, numIns, outputs, numOuts ); // solves auval 4099 error
@@ -442,45 +555,40 @@ tresult PLUGIN_API Transformant::setBusArrangements( SpeakerArrangement* inputs,
 #endif
     if ( numIns == 1 && numOuts == 1 )
     {
-        if ( isMonoInOut )
+        AudioBus* bus = FCast<AudioBus>( audioInputs.at( 0 ));
+        if ( bus )
         {
-            AudioBus* bus = FCast<AudioBus>( audioInputs.at( 0 ));
-            if ( bus )
+            // each channel is processed individually, as such we support any arrangement
+            // (e.g. Mono => Mono, Stereo => Stereo, 5.1 => 5.1) as long as the input and output are equal
+            // the formant filters are allocated for the channel amount in setupProcessing()
+
+            if ( inputs[ 0 ] == outputs[ 0 ] && numInChannels > 0 && numInChannels <= VST::MAX_CHANNELS )
             {
-                // check if we are Mono => Mono, if not we need to recreate the buses
-                if ( bus->getArrangement() != inputs[0])
+                // check if we are already in the requested arrangement, if not we need to recreate the buses
+                if ( bus->getArrangement() != inputs[ 0 ])
                 {
                     removeAudioBusses();
-                    addAudioInput ( STR16( "Mono In" ),  inputs [ 0 ] );
-                    addAudioOutput( STR16( "Mono Out" ), outputs[ 0 ] );
+                    if ( isMonoInOut ) {
+                        addAudioInput ( STR16( "Mono In" ),  inputs [ 0 ] );
+                        addAudioOutput( STR16( "Mono Out" ), outputs[ 0 ] );
+                    } else if ( isStereoInOut ) {
+                        addAudioInput ( STR16( "Stereo In" ),  inputs [ 0 ] );
+                        addAudioOutput( STR16( "Stereo Out" ), outputs[ 0 ] );
+                    } else {
+                        addAudioInput ( STR16( "Multichannel In" ),  inputs [ 0 ] );
+                        addAudioOutput( STR16( "Multichannel Out" ), outputs[ 0 ] );
+                    }
                 }
-                return kResultOk;
+                return kResultTrue;
             }
-        }
-        // the host wants something else than Mono => Mono, in this case we are always Stereo => Stereo
-        else
-        {
-            AudioBus* bus = FCast<AudioBus>( audioInputs.at( 0 ));
-            if ( bus )
+            // the host want something different (e.g. different arrangements for input and output) : in this case we want stereo
+            else if ( bus->getArrangement() != SpeakerArr::kStereo )
             {
-                // the host wants 2->2 (could be LsRs -> LsRs)
-                if ( isStereoInOut )
-                {
-                    removeAudioBusses();
-                    addAudioInput  ( STR16( "Stereo In"),  inputs [ 0 ] );
-                    addAudioOutput ( STR16( "Stereo Out"), outputs[ 0 ]);
-                    
-                    return kResultTrue;
-                }
-                // the host want something different than 1->1 or 2->2 : in this case we want stereo
-                else if ( bus->getArrangement() != SpeakerArr::kStereo )
-                {
-                    removeAudioBusses();
-                    addAudioInput ( STR16( "Stereo In"),  SpeakerArr::kStereo );
-                    addAudioOutput( STR16( "Stereo Out"), SpeakerArr::kStereo );
-                    
-                    return kResultFalse;
-                }
+                removeAudioBusses();
+                addAudioInput ( STR16( "Stereo In"),  SpeakerArr::kStereo );
+                addAudioOutput( STR16( "Stereo Out"), SpeakerArr::kStereo );
+
+                return kResultFalse;
             }
         }
     }
@@ -522,27 +630,220 @@ tresult PLUGIN_API Transformant::notify( IMessage* message )
         }
     }
 
+    // the controller requests the processing statistics (or their reset), note we're on the UI thread
+
+    if ( !strcmp( message->getMessageID(), "ProcessStatsRequest" ))
+    {
+        ProcessStats::Snapshot snapshot;
+        processStats.getSnapshot( snapshot );
+
+        if ( IPtr<IMessage> reply = owned( allocateMessage()))
+        {
+            reply->setMessageID( "ProcessStats" );
+            reply->getAttributes()->setInt  ( "blocks",         snapshot.blocks );
+            reply->getAttributes()->setInt  ( "overruns",       snapshot.overruns );
+            reply->getAttributes()->setInt  ( "worstBlockTime", ( int64 ) snapshot.worstBlockTime );
+            reply->getAttributes()->setFloat( "worstLoad",      snapshot.worstLoad );
+            reply->getAttributes()->setBinary( "histogram", snapshot.histogram, sizeof( snapshot.histogram ));
+
+            sendMessage( reply );
+        }
+        return kResultOk;
+    }
+
+    if ( !strcmp( message->getMessageID(), "ProcessStatsReset" ))
+    {
+        processStats.reset();
+        return kResultOk;
+    }
+
+    // the editor requests the visualisation feed at its frame rate, all frames written since the
+    // last request are sent in a single reply. Note the feed is only written while it is requested
+
+    if ( !strcmp( message->getMessageID(), "VisualisationRequest" ))
+    {
+        visualFeed.setEnabled( true );
+
+        std::vector<VisualFeed::Frame> frames( VisualFeed::CAPACITY );
+        int amount = visualFeed.read( frames.data(), VisualFeed::CAPACITY );
+
+        if ( amount == 0 ) {
+            return kResultOk;
+        }
+
+        if ( IPtr<IMessage> reply = owned( allocateMessage()))
+        {
+            reply->setMessageID( "Visualisation" );
+            reply->getAttributes()->setBinary( "frames", frames.data(), amount * sizeof( VisualFeed::Frame ));
+
+            sendMessage( reply );
+        }
+        return kResultOk;
+    }
+
+    if ( !strcmp( message->getMessageID(), "VisualisationStop" ))
+    {
+        visualFeed.setEnabled( false );
+        return kResultOk;
+    }
+
     return AudioEffect::notify( message );
 }
 
 void Transformant::syncModel()
 {
-    pluginProcess->distortionPostMix     = Calc::toBool( fDistortionChain );
-    pluginProcess->distortionTypeCrusher = Calc::toBool( fDistortionType );
-    pluginProcess->bitCrusher->setAmount( fDrive );
-    pluginProcess->waveShaper->setAmount( fDrive );
+    uint32 changed = parameters.consume();
 
-    pluginProcess->formantFilterL->setVowel( fVowelL );
-    pluginProcess->formantFilterL->setLFO( fLFOVowelL, fLFOVowelLDepth );
+    if ( changed == 0 ) {
+        return;
+    }
+
+    // update the model with the changed values
+
+    parameters.fetch( changed, kVowelLId,          fVowelL );
+    parameters.fetch( changed, kVowelRId,          fVowelR );
+    parameters.fetch( changed, kVowelSyncId,       fVowelSync );
+    parameters.fetch( changed, kLFOVowelLId,       fLFOVowelL );
+    parameters.fetch( changed, kLFOVowelRId,       fLFOVowelR );
+    parameters.fetch( changed, kLFOVowelLDepthId,  fLFOVowelLDepth );
+    parameters.fetch( changed, kLFOVowelRDepthId,  fLFOVowelRDepth );
+    parameters.fetch( changed, kDistortionTypeId,  fDistortionType );
+    parameters.fetch( changed, kDriveId,           fDrive );
+    parameters.fetch( changed, kDistortionChainId, fDistortionChain );
+    parameters.fetch( changed, kCpuBudgetId,       fCpuBudget );
 
-    // when vowel sync is on, both channels have the same vowel and LFO settings
+    // and only update the processor state affected by the changed values
+
+    if ( changed & ParameterStore::toFlag( kCpuBudgetId )) {
+        governor.setBudget( fCpuBudget );
+    }
 
-    if ( Calc::toBool( fVowelSync )) {
-        pluginProcess->formantFilterR->setVowel( fVowelL );
-        pluginProcess->formantFilterR->setLFO( fLFOVowelL, fLFOVowelLDepth );
+    if ( changed & ParameterStore::toFlag( kDistortionChainId )) {
+        pluginProcess->distortionPostMix = Calc::toBool( fDistortionChain );
+    }
+
+    if ( changed & ParameterStore::toFlag( kDistortionTypeId )) {
+        pluginProcess->distortionTypeCrusher = Calc::toBool( fDistortionType );
+    }
+
+    if ( changed & ParameterStore::toFlag( kDriveId )) {
+        pluginProcess->bitCrusher->setAmount( fDrive );
+        pluginProcess->waveShaper->setAmount( fDrive );
+    }
+
+    uint32 vowelLFlags = ParameterStore::toFlag( kVowelLId );
+    uint32 lfoLFlags   = ParameterStore::toFlag( kLFOVowelLId ) | ParameterStore::toFlag( kLFOVowelLDepthId );
+    uint32 vowelRFlags = ParameterStore::toFlag( kVowelRId );
+    uint32 lfoRFlags   = ParameterStore::toFlag( kLFOVowelRId ) | ParameterStore::toFlag( kLFOVowelRDepthId );
+    uint32 syncFlag    = ParameterStore::toFlag( kVowelSyncId );
+
+    // when vowel sync is on, all channels have the same vowel and LFO settings
+    // otherwise the even channels use the left and the odd channels use the right settings
+
+    pluginProcess->vowelSync = Calc::toBool( fVowelSync );
+
+    for ( int c = 0, l = pluginProcess->getFormantFilterAmount(); c < l; ++c )
+    {
+        FormantFilter* formantFilter = pluginProcess->getFormantFilter( c );
+
+        if ( c % 2 == 0 ) {
+            if ( changed & vowelLFlags ) {
+                formantFilter->setVowel( fVowelL );
+            }
+            if ( changed & lfoLFlags ) {
+                formantFilter->setLFO( fLFOVowelL, fLFOVowelLDepth );
+            }
+        } else if ( pluginProcess->vowelSync ) {
+            if ( changed & ( vowelLFlags | syncFlag )) {
+                formantFilter->setVowel( fVowelL );
+            }
+            if ( changed & ( lfoLFlags | syncFlag )) {
+                formantFilter->setLFO( fLFOVowelL, fLFOVowelLDepth );
+            }
+        } else {
+            if ( changed & ( vowelRFlags | syncFlag )) {
+                formantFilter->setVowel( fVowelR );
+            }
+            if ( changed & ( lfoRFlags | syncFlag )) {
+                formantFilter->setLFO( fLFOVowelR, fLFOVowelRDepth );
+            }
+        }
+    }
+}
+
+void Transformant::updateMeters( IParameterChanges* outParamChanges, int32 numSamples )
+{
+    meterSamples += numSamples;
+
+    if ( meterSamples < ( int32 ) ( processSetup.sampleRate / METER_RATE )) {
+        return;
+    }
+
+    // the meters are accumulated by the limiter while writing the output
+
+    Limiter* limiter = pluginProcess->limiter;
+    float values[ METER_AMOUNT ];
+
+    for ( int c = 0; c < Limiter::METER_CHANNELS; ++c ) {
+        values[ c ] = std::min( 1.f, limiter->getPeak( c ));
+        values[ Limiter::METER_CHANNELS + c ] = std::min( 1.f, ( float ) sqrt( limiter->getSumOfSquares( c ) / meterSamples ));
+    }
+    values[ METER_AMOUNT - 1 ] = std::min( 1.f, limiter->getMinimumGain());
+
+    limiter->resetMeter();
+    meterSamples = 0;
+
+    if ( !outParamChanges ) {
+        return;
+    }
+
+    // the parameters the meters are reported to (in the order of the values above)
+
+    static const ParamID METER_IDS[ METER_AMOUNT ] = {
+        kOutputPeakLId, kOutputPeakRId, kOutputRMSLId, kOutputRMSRId, kVuPPMId
+    };
+
+    for ( int i = 0; i < METER_AMOUNT; ++i ) {
+        if ( fabs( values[ i ] - meterValues[ i ]) <= METER_EPSILON ) {
+            continue;
+        }
+        int32 index = 0;
+        IParamValueQueue* paramQueue = outParamChanges->addParameterData( METER_IDS[ i ], index );
+        if ( paramQueue ) {
+            paramQueue->addPoint( 0, values[ i ], index );
+            meterValues[ i ] = values[ i ];
+        }
+    }
+}
+
+void Transformant::resetMeters()
+{
+    meterSamples = 0;
+
+    // out of range values ensure all meters are reported upon the next update
+
+    for ( int i = 0; i < METER_AMOUNT; ++i ) {
+        meterValues[ i ] = -1.f;
+    }
+    pluginProcess->limiter->resetMeter();
+}
+
+void Transformant::writeVisualFeed( void** out, int32 numOutChannels, int32 numSamples, bool isDoublePrecision )
+{
+    int amountOfFilters = pluginProcess->getFormantFilterAmount();
+
+    for ( int c = 0; c < VisualFeed::CHANNELS; ++c ) {
+        FormantFilter* formantFilter   = pluginProcess->getFormantFilter( std::min( c, amountOfFilters - 1 ));
+        VisualFeed::Formants* formants = visualFeed.getFormants( c );
+
+        formants->vowel = formantFilter->getCurrentVowel();
+        formantFilter->getFormants( formants->frequencies, formants->amplitudes );
+    }
+
+    if ( isDoublePrecision ) {
+        visualFeed.write<double>(( double** ) out, numOutChannels, numSamples, processSetup.sampleRate );
     } else {
-        pluginProcess->formantFilterR->setVowel( fVowelR );
-        pluginProcess->formantFilterR->setLFO( fLFOVowelR, fLFOVowelRDepth );
+        visualFeed.write<float>(( float** ) out, numOutChannels, numSamples, processSetup.sampleRate );
     }
 }
 
@@ -25,6 +25,11 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 #include "pluginprocess.h"
+#include "paramstore.h"
+#include "cpugovernor.h"
+#include "processstats.h"
+#include "logger.h"
+#include "visualfeed.h"
 #include "global.h"
 
 using namespace Steinberg::Vst;
@@ -79,12 +84,16 @@ class Transformant : public AudioEffect
         /** We want to receive message. */
         tresult PLUGIN_API notify( IMessage* message ) SMTG_OVERRIDE;
 
+        /** Processing time statistics (can also be requested by the controller, see notify()) */
+        ProcessStats* getProcessStats() { return &processStats; }
+
     //------------------------------------------------------------------------
     protected:
         //==============================================================================
 
         // our model values, these are all 0 - 1 range
         // (normalized) RangeParameter values
+        // these reflect the values currently applied to the processors
 
         float fVowelL;
         float fVowelR;
@@ -96,16 +105,67 @@ class Transformant : public AudioEffect
         float fDistortionType;
         float fDrive;
         float fDistortionChain;
+        float fCpuBudget;
+
+        // latest parameter values as received from the host / restored from state
+        // only the changed parameters are applied to the model upon syncModel()
+
+        ParameterStore parameters;
+
+        // the output meters (see Limiter) are reported to the controller at METER_RATE (in Hz), a
+        // meter is only reported when its value has changed by more than METER_EPSILON
+
+        static const int METER_RATE   = 30;
+        static const int METER_AMOUNT = Limiter::METER_CHANNELS * 2 + 1; // peak and RMS per channel and limiter gain
+
+        static constexpr float METER_EPSILON = 0.001f;
 
-        float outputGainOld; // for visualizing output gain in DAW
+        int32 meterSamples;               // amount of samples metered since the last report
+        float meterValues[ METER_AMOUNT ]; // the values last reported to the controller
 
         int32 currentProcessMode;
 
+        // steps down the processing quality when the realtime CPU budget is exceeded
+
+        CpuGovernor governor;
+
+        // timing of the processed blocks (e.g. to determine which instance exceeded its budget)
+
+        ProcessStats processStats;
+
+        // the quality tier last reported to the controller (-1 when not reported yet)
+
+        int32 reportedQualityTier;
+
+        // diagnostics logged from the audio thread (only created when the TRANSFORMANT_LOG_FILE
+        // environment variable specifies the file to log to, nullptr otherwise)
+
+        Logger* logger;
+
+        // output and formant state for visualisation in the editor (enabled by the controller)
+
+        VisualFeed visualFeed;
+
         Igorski::PluginProcess* pluginProcess;
 
         // synchronize the processors model with UI led changes
+        // only the processor state affected by the changed parameters is updated
 
         void syncModel();
+
+        // report the output meters once METER_RATE worth of samples have been metered
+        // should only be invoked by the audio thread (after processing given amount of samples)
+
+        void updateMeters( IParameterChanges* outParamChanges, int32 numSamples );
+
+        // ensures the next meter report includes all meters
+
+        void resetMeters();
+
+        // hand the output (in given buffers) and current formant state to the visual feed
+        // should only be invoked by the audio thread (while the feed is enabled)
+
+        void writeVisualFeed( void** out, int32 numOutChannels, int32 numSamples, bool isDoublePrecision );
 };
 
 }
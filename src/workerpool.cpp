@@ -0,0 +1,167 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "workerpool.h"
+#include <algorithm>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace Igorski {
+
+static void getThreadPriority( WorkerPool::ThreadPriority& threadPriority )
+{
+#ifdef _WIN32
+    threadPriority.policy   = 0;
+    threadPriority.priority = GetThreadPriority( GetCurrentThread());
+#else
+    sched_param param;
+    pthread_getschedparam( pthread_self(), &threadPriority.policy, &param );
+    threadPriority.priority = param.sched_priority;
+#endif
+}
+
+static void setThreadPriority( const WorkerPool::ThreadPriority& threadPriority )
+{
+    // note this can fail when the process lacks the privileges, the worker then keeps its priority
+#ifdef _WIN32
+    SetThreadPriority( GetCurrentThread(), threadPriority.priority );
+#else
+    sched_param param;
+    param.sched_priority = threadPriority.priority;
+    pthread_setschedparam( pthread_self(), threadPriority.policy, &param );
+#endif
+}
+
+/* constructor / destructor */
+
+WorkerPool::WorkerPool( int amountOfThreads )
+{
+    _task    = nullptr;
+    _context = nullptr;
+
+    _state.store( 0 );
+    _completedTasks.store( 0 );
+    _running.store( true );
+    _hasPriority.store( false );
+
+    for ( int i = 0; i < amountOfThreads; ++i ) {
+        _threads.emplace_back( &WorkerPool::work, this );
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    _running.store( false, std::memory_order_release );
+    _wake.post(( int ) _threads.size());
+
+    for ( auto& thread : _threads ) {
+        thread.join();
+    }
+}
+
+/* public methods */
+
+int WorkerPool::getAmountOfThreads()
+{
+    return ( int ) _threads.size();
+}
+
+void WorkerPool::run( Task task, void* context, int amountOfTasks )
+{
+    // the workers adopt the priority of the (audio) thread running the tasks, which is
+    // only known once run() is invoked. Retrieving the priority does not block
+
+    if ( !_hasPriority.load( std::memory_order_relaxed )) {
+        getThreadPriority( _priority );
+        _hasPriority.store( true, std::memory_order_release );
+    }
+
+    // the previous run has completed, no worker can be accessing the task properties
+
+    _task    = task;
+    _context = context;
+
+    _completedTasks.store( 0, std::memory_order_relaxed );
+    _state.store(( uint64_t ) amountOfTasks << 32, std::memory_order_release );
+
+    // wake up as many workers as there are tasks left for them (the calling thread executes tasks too)
+    // a worker waking up after all tasks have been claimed returns to waiting without doing anything
+
+    _wake.post( std::min( amountOfTasks - 1, ( int ) _threads.size()));
+
+    execute();
+
+    while ( _completedTasks.load( std::memory_order_acquire ) < amountOfTasks ) {
+        std::this_thread::yield();
+    }
+}
+
+/* private methods */
+
+void WorkerPool::work()
+{
+    bool hasPriority = false;
+
+    while ( true )
+    {
+        _wake.wait();
+
+        if ( !_running.load( std::memory_order_acquire )) {
+            return;
+        }
+
+        if ( !hasPriority && _hasPriority.load( std::memory_order_acquire )) {
+            setThreadPriority( _priority );
+            hasPriority = true;
+        }
+        execute();
+    }
+}
+
+void WorkerPool::execute()
+{
+    uint64_t state = _state.load( std::memory_order_acquire );
+
+    while ( true )
+    {
+        uint32_t index  = ( uint32_t ) state;
+        uint32_t amount = ( uint32_t ) ( state >> 32 );
+
+        if ( index >= amount ) {
+            return;
+        }
+
+        // claim the task, on failure state holds the current value to retry with
+
+        if ( _state.compare_exchange_weak( state, state + 1, std::memory_order_acq_rel, std::memory_order_acquire )) {
+            _task( _context, ( int ) index );
+            _completedTasks.fetch_add( 1, std::memory_order_release );
+
+            state = _state.load( std::memory_order_acquire );
+        }
+    }
+}
+
+}
@@ -0,0 +1,91 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __WORKERPOOL_H_INCLUDED__
+#define __WORKERPOOL_H_INCLUDED__
+
+#include "countingsemaphore.h"
+#include <atomic>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+namespace Igorski {
+
+/**
+ * WorkerPool maintains a fixed amount of threads which can be used
+ * to execute independent tasks (e.g. the processing of individual channels)
+ * in parallel. The calling thread participates in executing the tasks.
+ *
+ * Threads are created upon construction, which should not happen on the audio thread.
+ * Running tasks does not lock: the workers are woken through a semaphore and claim
+ * their tasks atomically. The workers adopt the scheduling priority of the thread
+ * invoking run() (e.g. the realtime priority of the audio thread).
+ */
+class WorkerPool
+{
+    public:
+        // a task receives the context provided to run() and the index of the task to execute
+
+        typedef void ( *Task )( void* context, int index );
+
+        WorkerPool( int amountOfThreads );
+        ~WorkerPool();
+
+        int getAmountOfThreads();
+
+        // executes given task for each index in the 0 - amountOfTasks range, distributed
+        // over the worker threads and the calling thread. Returns once all tasks have completed
+
+        void run( Task task, void* context, int amountOfTasks );
+
+        // scheduling policy and priority of a thread (the policy is unused on Windows)
+
+        struct ThreadPriority {
+            int policy;
+            int priority;
+        };
+
+    private:
+        std::vector<std::thread> _threads;
+        CountingSemaphore _wake;
+
+        Task  _task;
+        void* _context;
+
+        // the amount of tasks of the current run (upper 32 bits) and the index of the
+        // next task to claim (lower 32 bits), updated as a whole so a worker can never
+        // claim a task of a run using the amount of another run
+
+        std::atomic<uint64_t> _state;
+        std::atomic<int>      _completedTasks;
+        std::atomic<bool>     _running;
+
+        ThreadPriority    _priority;
+        std::atomic<bool> _hasPriority;
+
+        void work();
+        void execute();
+};
+}
+
+#endif